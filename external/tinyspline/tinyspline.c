@@ -7,6 +7,7 @@
 #include <string.h> /* memcpy, memmove */
 #include <stdio.h>  /* FILE, fopen */
 #include <stdarg.h> /* varargs */
+#include <limits.h> /* UINT_MAX */
 
 /* Suppress some useless MSVC warnings. */
 #ifdef _MSC_VER
@@ -36,7 +37,26 @@
  * @{
  */
 /**
- * Stores the private data of ::tsBSpline.
+ * Reference counted array of ::tsReal values. The values are stored right
+ * after the struct. Blocks are shared between splines (see ::ts_bspline_copy)
+ * and must not be written to as long as \c refs is greater than 1 or the block
+ * is interned (copy-on-write, see ::ts_int_bspline_own_ctrlp and
+ * ::ts_int_bspline_own_knots).
+ */
+struct tsBlock
+{
+	size_t refs; /**< Number of splines referencing this block. */
+	size_t len; /**< Number of values (may exceed the number in use). */
+	int interned; /**< Whether this block is in the knot pool. */
+	unsigned long hash; /**< Hash of the values (interned blocks only). */
+	struct tsBlock *next; /**< Next block in the same pool bucket. */
+};
+
+/**
+ * Stores the private data of ::tsBSpline. Control points and knots are stored
+ * in separate, shared blocks so that copies only have to allocate the struct.
+ * Knot vectors generated by ::ts_bspline_new are interned, that is, splines
+ * with identical knot vectors reference the same block.
  */
 struct tsBSplineImpl
 {
@@ -44,6 +64,8 @@ struct tsBSplineImpl
 	size_t dim; /**< Dimensionality of the control points (2D => x, y). */
 	size_t n_ctrlp; /**< Number of control points. */
 	size_t n_knots; /**< Number of knots (n_ctrlp + deg + 1). */
+	struct tsBlock *ctrlp; /**< Control points (n_ctrlp * dim). */
+	struct tsBlock *knots; /**< Knots (n_knots). */
 };
 
 /**
@@ -59,37 +81,337 @@ struct tsDeBoorNetImpl
 	size_t n_points; /** Number of points in `points'. */
 };
 
+/**
+ * Stores the private data of ::tsStreamInterp. The following buffers are
+ * stored right after the struct:
+ *
+ *     [points (cap * dim), aux (2 * dim), d (window * dim), cc (window)]
+ *
+ * where \c cap is \c window + 2 for cubic natural streams and \c 3 for
+ * Catmull-Rom streams. Cubic natural streams store the last fixed B-Spline
+ * control point in \c aux and use \c d and \c cc to solve the windowed
+ * system of linear equations. Catmull-Rom streams store their (generated)
+ * first and last point in \c aux.
+ */
+struct tsStreamInterpImpl
+{
+	int natural; /**< Cubic natural (1) or Catmull-Rom (0). */
+	size_t dim; /**< Dimensionality of the points. */
+	size_t window; /**< Number of look-ahead points (cubic natural). */
+	tsReal alpha; /**< Knot parameterization (Catmull-Rom). */
+	tsReal epsilon; /**< Distance of duplicate points (Catmull-Rom). */
+	size_t n_points; /**< Number of buffered points. */
+	size_t n_seen; /**< Number of accepted points since the last reset. */
+	size_t n_segs; /**< Number of emitted segments since the last reset. */
+};
+
+/**
+ * Stores the private data of ::tsMorphPlan. The control points and knots of
+ * the aligned origin and target are stored (in this order) right after the
+ * struct:
+ *
+ *     [origin ctrlp, target ctrlp, origin knots, target knots]
+ *
+ * If the aligned origin and target share their knots, the knots are not
+ * copied. Instead, \c knots references the shared block.
+ */
+struct tsMorphPlanImpl
+{
+	size_t deg; /**< Degree of the aligned splines. */
+	size_t dim; /**< Dimensionality of the blended control points. */
+	size_t n_ctrlp; /**< Number of control points of the aligned splines. */
+	size_t n_knots; /**< Number of knots of the aligned splines. */
+	struct tsBlock *knots; /**< Shared knots (or NULL). */
+};
+
+/* Blocks are only shared if reference counts and the knot pool can be updated
+ * atomically. Otherwise, every spline owns its blocks, that is, copies are
+ * deep and knot vectors are not interned. */
+#if defined(__clang__) || \
+    (defined(__GNUC__) && (__GNUC__ * 100 + __GNUC_MINOR__) >= 407)
+#define TS_INT_SHARE_BLOCKS
+#endif
+
+#ifdef TS_INT_SHARE_BLOCKS
+#define TS_INT_KNOT_POOL_SIZE 256
+
+/* Interned knot vectors, hashed by value. The pool does not hold references
+ * on its own: blocks are removed when their last reference is released. */
+static struct tsBlock *ts_int_knot_pool[TS_INT_KNOT_POOL_SIZE];
+static char ts_int_knot_pool_busy = 0;
+
+/* Number of times a thread polls the knot pool lock before yielding. */
+#define TS_INT_KNOT_POOL_SPINS 64
+#if defined(__unix__) || defined(__APPLE__)
+#include <sched.h> /* sched_yield */
+#define TS_INT_YIELD() sched_yield()
+#else
+#define TS_INT_YIELD()
+#endif
+
 void
-ts_int_bspline_init(tsBSpline *spline)
+ts_int_knot_pool_lock(void)
 {
-	spline->pImpl = NULL;
+	/* Critical sections are short. Poll with plain loads for a while and,
+	 * if the lock is still taken (e.g. its holder has been preempted),
+	 * give the CPU to another thread. */
+	unsigned int spins = 0;
+	while (__atomic_test_and_set(&ts_int_knot_pool_busy,
+	                             __ATOMIC_ACQUIRE)) {
+		while (__atomic_load_n(&ts_int_knot_pool_busy,
+		                       __ATOMIC_RELAXED)) {
+			if (++spins < TS_INT_KNOT_POOL_SPINS) continue;
+			spins = 0;
+			TS_INT_YIELD();
+		}
+	}
 }
 
-size_t
-ts_int_bspline_sof_state(const tsBSpline *spline)
+void
+ts_int_knot_pool_unlock(void)
 {
-	return sizeof(struct tsBSplineImpl) +
-	       ts_bspline_sof_control_points(spline) +
-	       ts_bspline_sof_knots(spline);
+	__atomic_clear(&ts_int_knot_pool_busy, __ATOMIC_RELEASE);
 }
+#endif
 
 tsReal *
+ts_int_block_values(const struct tsBlock *block)
+{
+	return (tsReal *) (& block[1]);
+}
+
+tsError
+ts_int_block_new(size_t len,
+                 struct tsBlock **block,
+                 tsStatus *status)
+{
+	*block = (struct tsBlock *) malloc(
+		sizeof(struct tsBlock) + len * sizeof(tsReal));
+	if (!*block) TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	(*block)->refs = 1;
+	(*block)->len = len;
+	(*block)->interned = 0;
+	(*block)->hash = 0;
+	(*block)->next = NULL;
+	TS_RETURN_SUCCESS(status)
+}
+
+tsError
+ts_int_block_clone(const struct tsBlock *block,
+                   size_t len, /* number of values in use */
+                   struct tsBlock **clone,
+                   tsStatus *status)
+{
+	tsError err;
+	TS_CALL_ROE(err, ts_int_block_new(len, clone, status))
+	memcpy(ts_int_block_values(*clone),
+	       ts_int_block_values(block),
+	       len * sizeof(tsReal));
+	TS_RETURN_SUCCESS(status)
+}
+
+#ifdef TS_INT_SHARE_BLOCKS
+unsigned long
+ts_int_block_hash(const struct tsBlock *block)
+{
+	const unsigned char *bytes = (const unsigned char *)
+		ts_int_block_values(block);
+	const size_t size = block->len * sizeof(tsReal);
+	unsigned long hash = 2166136261UL; /* FNV-1a */
+	size_t i;
+	for (i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= 16777619UL;
+	}
+	return hash;
+}
+
+/* The knot pool must be locked. */
+void
+ts_int_block_unlink(struct tsBlock *block)
+{
+	struct tsBlock **link =
+		&ts_int_knot_pool[block->hash % TS_INT_KNOT_POOL_SIZE];
+	while (*link != block)
+		link = &(*link)->next;
+	*link = block->next;
+	block->interned = 0;
+	block->next = NULL;
+}
+#endif
+
+void
+ts_int_block_release(struct tsBlock *block)
+{
+#ifdef TS_INT_SHARE_BLOCKS
+	size_t refs;
+	if (!block) return;
+	if (block->interned) {
+		/* Decrement and unlink atomically. Otherwise, the pool could
+		 * hand out a block that is about to be freed. */
+		ts_int_knot_pool_lock();
+		refs = __atomic_sub_fetch(&block->refs, 1, __ATOMIC_ACQ_REL);
+		if (refs == 0) ts_int_block_unlink(block);
+		ts_int_knot_pool_unlock();
+	} else {
+		refs = __atomic_sub_fetch(&block->refs, 1, __ATOMIC_ACQ_REL);
+	}
+	if (refs == 0) free(block);
+#else
+	if (block) free(block);
+#endif
+}
+
+tsError
+ts_int_block_share(struct tsBlock *block,
+                   size_t len, /* number of values in use */
+                   struct tsBlock **shared,
+                   tsStatus *status)
+{
+#ifdef TS_INT_SHARE_BLOCKS
+	(void) len;
+	__atomic_add_fetch(&block->refs, 1, __ATOMIC_RELAXED);
+	*shared = block;
+	TS_RETURN_SUCCESS(status)
+#else
+	return ts_int_block_clone(block, len, shared, status);
+#endif
+}
+
+void
+ts_int_block_intern(struct tsBlock **block)
+{
+#ifdef TS_INT_SHARE_BLOCKS
+	struct tsBlock *fresh = *block, *iter;
+	const unsigned long hash = ts_int_block_hash(fresh);
+	const size_t bucket = hash % TS_INT_KNOT_POOL_SIZE;
+
+	ts_int_knot_pool_lock();
+	for (iter = ts_int_knot_pool[bucket]; iter; iter = iter->next) {
+		if (iter->hash == hash && iter->len == fresh->len &&
+		    memcmp(ts_int_block_values(iter),
+		           ts_int_block_values(fresh),
+		           fresh->len * sizeof(tsReal)) == 0)
+			break;
+	}
+	if (iter) {
+		__atomic_add_fetch(&iter->refs, 1, __ATOMIC_RELAXED);
+	} else {
+		fresh->hash = hash;
+		fresh->interned = 1;
+		fresh->next = ts_int_knot_pool[bucket];
+		ts_int_knot_pool[bucket] = fresh;
+	}
+	ts_int_knot_pool_unlock();
+
+	if (iter) {
+		free(fresh);
+		*block = iter;
+	}
+#else
+	(void) block;
+#endif
+}
+
+tsError
+ts_int_block_own(struct tsBlock **block,
+                 size_t len, /* number of values in use */
+                 tsStatus *status)
+{
+#ifdef TS_INT_SHARE_BLOCKS
+	struct tsBlock *clone;
+	tsError err;
+	if ((*block)->interned) {
+		/* The values of interned blocks must not change. If this is
+		 * the only reference, the block can be taken out of the pool
+		 * instead of being cloned. */
+		ts_int_knot_pool_lock();
+		if (__atomic_load_n(&(*block)->refs, __ATOMIC_ACQUIRE) == 1)
+			ts_int_block_unlink(*block);
+		ts_int_knot_pool_unlock();
+	}
+	if (!(*block)->interned &&
+	    __atomic_load_n(&(*block)->refs, __ATOMIC_ACQUIRE) == 1)
+		TS_RETURN_SUCCESS(status)
+	TS_CALL_ROE(err, ts_int_block_clone(*block, len, &clone, status))
+	ts_int_block_release(*block);
+	*block = clone;
+#else
+	(void) block;
+	(void) len;
+#endif
+	TS_RETURN_SUCCESS(status)
+}
+
+/* `block' must be owned (see ts_int_block_own). If `realloc' fails, the old
+ * block is still valid and merely larger than needed. */
+void
+ts_int_block_shrink(struct tsBlock **block,
+                    size_t len)
+{
+	struct tsBlock *shrunk;
+	if (len >= (*block)->len) return;
+	shrunk = (struct tsBlock *) realloc(
+		*block, sizeof(struct tsBlock) + len * sizeof(tsReal));
+	if (!shrunk) return;
+	shrunk->len = len;
+	*block = shrunk;
+}
+
+void
+ts_int_bspline_init(tsBSpline *spline)
+{
+	spline->pImpl = NULL;
+}
+
+const tsReal *
 ts_int_bspline_access_ctrlp(const tsBSpline *spline)
 {
-	return (tsReal *) (& spline->pImpl[1]);
+	return ts_int_block_values(spline->pImpl->ctrlp);
 }
 
-tsReal *
+const tsReal *
 ts_int_bspline_access_knots(const tsBSpline *spline)
 {
-	return ts_int_bspline_access_ctrlp(spline) +
-	       ts_bspline_len_control_points(spline);
+	return ts_int_block_values(spline->pImpl->knots);
+}
+
+tsError
+ts_int_bspline_own_ctrlp(tsBSpline *spline,
+                         tsReal **ctrlp,
+                         tsStatus *status)
+{
+	tsError err;
+	TS_CALL_ROE(err, ts_int_block_own(&spline->pImpl->ctrlp,
+	            ts_bspline_len_control_points(spline), status))
+	*ctrlp = ts_int_block_values(spline->pImpl->ctrlp);
+	TS_RETURN_SUCCESS(status)
+}
+
+tsError
+ts_int_bspline_own_knots(tsBSpline *spline,
+                         tsReal **knots,
+                         tsStatus *status)
+{
+	tsError err;
+	TS_CALL_ROE(err, ts_int_block_own(&spline->pImpl->knots,
+	            ts_bspline_num_knots(spline), status))
+	*knots = ts_int_block_values(spline->pImpl->knots);
+	TS_RETURN_SUCCESS(status)
+}
+
+/* Only for splines just created with ts_bspline_new, whose control points are
+ * never shared. */
+tsReal *
+ts_int_bspline_unshared_ctrlp(const tsBSpline *spline)
+{
+	return ts_int_block_values(spline->pImpl->ctrlp);
 }
 
 tsError
 ts_int_bspline_access_ctrlp_at(const tsBSpline *spline,
                                size_t index,
-                               tsReal **ctrlp,
+                               const tsReal **ctrlp,
                                tsStatus *status)
 {
 	const size_t num = ts_bspline_num_control_points(spline);
@@ -153,6 +475,145 @@ ts_int_deboornet_access_result(const tsDeBoorNet *net)
 		        ts_deboornet_dimension(net));
 	}
 }
+
+void
+ts_int_morphplan_init(tsMorphPlan *plan)
+{
+	plan->pImpl = NULL;
+}
+
+tsReal *
+ts_int_morphplan_access_ctrlp(const tsMorphPlan *plan)
+{
+	return (tsReal *) (& plan->pImpl[1]);
+}
+
+tsReal *
+ts_int_morphplan_access_knots(const tsMorphPlan *plan)
+{
+	return ts_int_morphplan_access_ctrlp(plan) +
+	       2 * plan->pImpl->n_ctrlp * plan->pImpl->dim;
+}
+
+void
+ts_int_streaminterp_init(tsStreamInterp *stream)
+{
+	stream->pImpl = NULL;
+}
+
+tsReal *
+ts_int_streaminterp_access_points(const tsStreamInterp *stream)
+{
+	return (tsReal *) (& stream->pImpl[1]);
+}
+
+tsReal *
+ts_int_streaminterp_access_aux(const tsStreamInterp *stream)
+{
+	const size_t cap = stream->pImpl->natural
+		? stream->pImpl->window + 2 : 3;
+	return ts_int_streaminterp_access_points(stream) +
+	       cap * stream->pImpl->dim;
+}
+
+tsReal *
+ts_int_streaminterp_access_d(const tsStreamInterp *stream)
+{
+	return ts_int_streaminterp_access_aux(stream) +
+	       2 * stream->pImpl->dim;
+}
+
+tsReal *
+ts_int_streaminterp_access_cc(const tsStreamInterp *stream)
+{
+	return ts_int_streaminterp_access_d(stream) +
+	       stream->pImpl->window * stream->pImpl->dim;
+}
+
+void
+ts_int_basis_ders(const tsReal *knots,
+                  size_t deg,
+                  size_t span,
+                  tsReal u,
+                  size_t n,
+                  tsReal *ws,
+                  tsReal *ders)
+{
+	/* Based on algorithm A2.3 of 'The NURBS Book' (Les Piegl and Wayne
+	 * Tiller). `ws' must provide space for `ndu', `left', `right', and the
+	 * two rows of `a'. `ders' is a (n+1) x order matrix (row major) that
+	 * receives the basis functions (row 0) and their derivatives (row k).
+	 * The caller must ensure that n <= deg. */
+	const int p = (int) deg;
+	const int order = p + 1;
+	tsReal *ndu = ws;                  /**< Basis functions and knot
+	                                     *   differences. */
+	tsReal *left = ndu + order*order;  /**< u - u_{span+1-j}. */
+	tsReal *right = left + order;      /**< u_{span+j} - u. */
+	tsReal *a[2];                      /**< Rows of the coefficients. */
+	tsReal *swp;                       /**< Used to swap the rows of a. */
+	tsReal saved, temp, d, fac;
+	int j, r, k, rk, pk, j1, j2;
+
+	a[0] = right + order;
+	a[1] = a[0] + order;
+
+	/* Basis functions and knot differences. */
+	ndu[0] = (tsReal) 1.0;
+	for (j = 1; j <= p; j++) {
+		left[j] = u - knots[span + 1 - j];
+		right[j] = knots[span + j] - u;
+		saved = (tsReal) 0.0;
+		for (r = 0; r < j; r++) {
+			/* Lower triangle. */
+			ndu[j*order + r] = right[r+1] + left[j-r];
+			temp = ndu[r*order + j-1] / ndu[j*order + r];
+			/* Upper triangle. */
+			ndu[r*order + j] = saved + right[r+1] * temp;
+			saved = left[j-r] * temp;
+		}
+		ndu[j*order + j] = saved;
+	}
+	for (j = 0; j <= p; j++)
+		ders[j] = ndu[j*order + p];
+
+	/* Derivatives. */
+	for (r = 0; r <= p; r++) {
+		a[0][0] = (tsReal) 1.0;
+		for (k = 1; k <= (int) n; k++) {
+			d = (tsReal) 0.0;
+			rk = r - k;
+			pk = p - k;
+			if (r >= k) {
+				a[1][0] = a[0][0] / ndu[(pk+1)*order + rk];
+				d = a[1][0] * ndu[rk*order + pk];
+			}
+			j1 = rk >= -1 ? 1 : -rk;
+			j2 = r-1 <= pk ? k-1 : p-r;
+			for (j = j1; j <= j2; j++) {
+				a[1][j] = (a[0][j] - a[0][j-1]) /
+				          ndu[(pk+1)*order + rk+j];
+				d += a[1][j] * ndu[(rk+j)*order + pk];
+			}
+			if (r <= pk) {
+				a[1][k] = -a[0][k-1] / ndu[(pk+1)*order + r];
+				d += a[1][k] * ndu[r*order + pk];
+			}
+			ders[k*order + r] = d;
+			swp = a[0];
+			a[0] = a[1];
+			a[1] = swp;
+		}
+	}
+
+	/* Multiply through by the correct factors. */
+	fac = (tsReal) p;
+	for (k = 1; k <= (int) n; k++) {
+		for (j = 0; j <= p; j++)
+			ders[k*order + j] *= fac;
+		fac *= (tsReal) (p-k);
+	}
+}
 /*! @} */
 
 
@@ -222,12 +683,10 @@ ts_bspline_control_point_at_ptr(const tsBSpline *spline,
                                 const tsReal **ctrlp,
                                 tsStatus *status)
 {
-	tsReal *vals;
 	tsError err;
 	TS_TRY(try, err, status)
 		TS_CALL(try, err, ts_int_bspline_access_ctrlp_at(
-		        spline, index, &vals, status))
-		*ctrlp = vals;
+		        spline, index, ctrlp, status))
 	TS_CATCH(err)
 		*ctrlp = NULL;
 	TS_END_TRY_RETURN(err)
@@ -239,7 +698,10 @@ ts_bspline_set_control_points(tsBSpline *spline,
                               tsStatus *status)
 {
 	const size_t size = ts_bspline_sof_control_points(spline);
-	memmove(ts_int_bspline_access_ctrlp(spline), ctrlp, size);
+	tsReal *to;
+	tsError err;
+	TS_CALL_ROE(err, ts_int_bspline_own_ctrlp(spline, &to, status))
+	memmove(to, ctrlp, size);
 	TS_RETURN_SUCCESS(status)
 }
 
@@ -249,14 +711,18 @@ ts_bspline_set_control_point_at(tsBSpline *spline,
                                 const tsReal *ctrlp,
                                 tsStatus *status)
 {
+	const tsReal *at;
 	tsReal *to;
-	size_t size;
+	size_t offset, size;
 	tsError err;
 	TS_TRY(try, err, status)
 		TS_CALL(try, err, ts_int_bspline_access_ctrlp_at(
-		        spline, index, &to, status))
+		        spline, index, &at, status))
+		offset = at - ts_int_bspline_access_ctrlp(spline);
+		TS_CALL(try, err, ts_int_bspline_own_ctrlp(
+		        spline, &to, status))
 		size = ts_bspline_dimension(spline) * sizeof(tsReal);
-		memcpy(to, ctrlp, size);
+		memmove(to + offset, ctrlp, size);
 	TS_END_TRY_RETURN(err)
 }
 
@@ -308,7 +774,8 @@ ts_bspline_set_knots(tsBSpline *spline,
 	const size_t num_knots = ts_bspline_num_knots(spline);
 	const size_t order = ts_bspline_order(spline);
 	size_t idx, mult;
-	tsReal lst_knot, knot;
+	tsReal lst_knot, knot, *to;
+	tsError err;
 	lst_knot = knots[0];
 	mult = 1;
 	for (idx = 1; idx < num_knots; idx++) {
@@ -330,7 +797,8 @@ ts_bspline_set_knots(tsBSpline *spline,
 		}
 		lst_knot = knot;
 	}
-	memmove(ts_int_bspline_access_knots(spline), knots, size);
+	TS_CALL_ROE(err, ts_int_bspline_own_knots(spline, &to, status))
+	memmove(to, knots, size);
 	TS_RETURN_SUCCESS(status)
 }
 
@@ -380,7 +848,8 @@ ts_bspline_set_knot_at(tsBSpline *spline,
 		/* knots must be set after reading oldKnot because the catch
 		 * block assumes that oldKnot contains the correct value if
 		 * knots is not NULL. */
-		knots = ts_int_bspline_access_knots(spline);
+		TS_CALL(try, err, ts_int_bspline_own_knots(
+		        spline, &knots, status))
 		knots[index] = knot;
 		TS_CALL(try, err, ts_bspline_set_knots(
 		        spline, knots, status))
@@ -406,7 +875,7 @@ ts_bspline_init(void)
 }
 
 tsError
-ts_int_bspline_generate_knots(const tsBSpline *spline,
+ts_int_bspline_generate_knots(tsBSpline *spline,
                               tsBSplineType type,
                               tsStatus *status)
 {
@@ -416,6 +885,7 @@ ts_int_bspline_generate_knots(const tsBSpline *spline,
 	tsReal fac; /**< Factor used to calculate the knot values. */
 	size_t i; /**< Used in for loops. */
 	tsReal *knots; /**< Pointer to the knots of \p _result_. */
+	tsError err;
 
 	/* order >= 1 implies 2*order >= 2 implies n_knots >= 2 */
 	if (type == TS_BEZIERS && n_knots % order != 0) {
@@ -424,7 +894,7 @@ ts_int_bspline_generate_knots(const tsBSpline *spline,
 		            (unsigned long) n_knots, (unsigned long) order)
 	}
 
-	knots = ts_int_bspline_access_knots(spline);
+	TS_CALL_ROE(err, ts_int_bspline_own_knots(spline, &knots, status))
 
 	if (type == TS_OPENED) {
 		knots[0] = TS_DOMAIN_DEFAULT_MIN; /* n_knots >= 2 */
@@ -456,22 +926,17 @@ ts_int_bspline_generate_knots(const tsBSpline *spline,
 }
 
 tsError
-ts_bspline_new(size_t num_control_points,
-               size_t dimension,
-               size_t degree,
-               tsBSplineType type,
-               tsBSpline *spline,
-               tsStatus *status)
+ts_int_bspline_new(size_t num_control_points,
+                   size_t dimension,
+                   size_t degree,
+                   tsBSplineType type,
+                   int intern, /* whether to intern the knot vector */
+                   tsBSpline *spline,
+                   tsStatus *status)
 {
 	const size_t order = degree + 1;
 	const size_t num_knots = num_control_points + order;
 	const size_t len_ctrlp = num_control_points * dimension;
-
-	const size_t sof_real = sizeof(tsReal);
-	const size_t sof_impl = sizeof(struct tsBSplineImpl);
-	const size_t sof_ctrlp_vec = len_ctrlp * sof_real;
-	const size_t sof_knots_vec = num_knots * sof_real;
-	const size_t sof_spline = sof_impl + sof_ctrlp_vec + sof_knots_vec;
 	tsError err;
 
 	ts_int_bspline_init(spline);
@@ -491,22 +956,49 @@ ts_bspline_new(size_t num_control_points,
 		            (unsigned long) num_control_points)
 	}
 
-	spline->pImpl = (struct tsBSplineImpl *) malloc(sof_spline);
+	spline->pImpl = (struct tsBSplineImpl *) malloc(
+		sizeof(struct tsBSplineImpl));
 	if (!spline->pImpl) TS_RETURN_0(status, TS_MALLOC, "out of memory")
 
 	spline->pImpl->deg = degree;
 	spline->pImpl->dim = dimension;
 	spline->pImpl->n_ctrlp = num_control_points;
 	spline->pImpl->n_knots = num_knots;
+	spline->pImpl->ctrlp = NULL;
+	spline->pImpl->knots = NULL;
 
 	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_int_block_new(
+		        len_ctrlp, &spline->pImpl->ctrlp, status))
+		TS_CALL(try, err, ts_int_block_new(
+		        num_knots, &spline->pImpl->knots, status))
 		TS_CALL(try, err, ts_int_bspline_generate_knots(
 		        spline, type, status))
+		/* Splines with the same type, degree, and number of control
+		 * points share their knot vector. Internal functions that
+		 * overwrite the generated knots anyway skip this step, which
+		 * saves hashing the knots and locking the knot pool (twice,
+		 * as the knots would have to be taken out of the pool again
+		 * before writing to them). */
+		if (intern)
+			ts_int_block_intern(&spline->pImpl->knots);
 	TS_CATCH(err)
 		ts_bspline_free(spline);
 	TS_END_TRY_RETURN(err)
 }
 
+tsError
+ts_bspline_new(size_t num_control_points,
+               size_t dimension,
+               size_t degree,
+               tsBSplineType type,
+               tsBSpline *spline,
+               tsStatus *status)
+{
+	return ts_int_bspline_new(num_control_points, dimension, degree,
+	                          type, 1, spline, status);
+}
+
 tsError
 ts_bspline_new_with_control_points(size_t num_control_points,
                                    size_t dimension,
@@ -529,7 +1021,7 @@ ts_bspline_new_with_control_points(size_t num_control_points,
 	TS_CATCH(err)
 		ts_bspline_free(spline);
 	TS_END_TRY_ROE(err)
-	ctrlp = ts_int_bspline_access_ctrlp(spline);
+	ctrlp = ts_int_bspline_unshared_ctrlp(spline);
 
 	ctrlp[0] = (tsReal) first;
 	va_start(argp, first);
@@ -545,14 +1037,26 @@ ts_bspline_copy(const tsBSpline *src,
                 tsBSpline *dest,
                 tsStatus *status)
 {
-	size_t size;
+	tsError err;
 	if (src == dest) TS_RETURN_SUCCESS(status)
 	ts_int_bspline_init(dest);
-	size = ts_int_bspline_sof_state(src);
-	dest->pImpl = (struct tsBSplineImpl *) malloc(size);
+	dest->pImpl = (struct tsBSplineImpl *) malloc(
+		sizeof(struct tsBSplineImpl));
 	if (!dest->pImpl) TS_RETURN_0(status, TS_MALLOC, "out of memory")
-	memcpy(dest->pImpl, src->pImpl, size);
-	TS_RETURN_SUCCESS(status)
+	*dest->pImpl = *src->pImpl;
+	dest->pImpl->ctrlp = NULL;
+	dest->pImpl->knots = NULL;
+	/* Control points and knots are copied on write. */
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_int_block_share(
+		        src->pImpl->ctrlp, ts_bspline_len_control_points(src),
+		        &dest->pImpl->ctrlp, status))
+		TS_CALL(try, err, ts_int_block_share(
+		        src->pImpl->knots, ts_bspline_num_knots(src),
+		        &dest->pImpl->knots, status))
+	TS_CATCH(err)
+		ts_bspline_free(dest);
+	TS_END_TRY_RETURN(err)
 }
 
 void
@@ -567,7 +1071,11 @@ ts_bspline_move(tsBSpline *src,
 void
 ts_bspline_free(tsBSpline *spline)
 {
-	if (spline->pImpl) free(spline->pImpl);
+	if (spline->pImpl) {
+		ts_int_block_release(spline->pImpl->ctrlp);
+		ts_int_block_release(spline->pImpl->knots);
+		free(spline->pImpl);
+	}
 	ts_int_bspline_init(spline);
 }
 /*! @} */
@@ -774,10 +1282,10 @@ ts_int_cubic_point(const tsReal *point,
 	tsReal *ctrlp = NULL;
 	size_t i;
 	tsError err;
-	TS_CALL_ROE(err, ts_bspline_new(
+	TS_CALL_ROE(err, ts_int_bspline_new(
 	            4, dim, 3,
-	            TS_CLAMPED, spline, status))
-	ctrlp = ts_int_bspline_access_ctrlp(spline);
+	            TS_CLAMPED, 0, spline, status))
+	ctrlp = ts_int_bspline_unshared_ctrlp(spline);
 	for (i = 0; i < 4; i++) {
 		memcpy(ctrlp + i*dim,
 		       point,
@@ -895,10 +1403,10 @@ ts_int_relaxed_uniform_cubic_bspline(const tsReal *points,
 	s = NULL;
 	TS_TRY(try, err, status)
 		/* n >= 2 implies n-1 >= 1 implies (n-1)*4 >= 4 */
-		TS_CALL(try, err, ts_bspline_new(
+		TS_CALL(try, err, ts_int_bspline_new(
 		        (n-1) * 4, dim, order - 1,
-		        TS_BEZIERS, spline, status))
-		ctrlp = ts_int_bspline_access_ctrlp(spline);
+		        TS_BEZIERS, 0, spline, status))
+		ctrlp = ts_int_bspline_unshared_ctrlp(spline);
 
 		s = (tsReal*) malloc(n * sof_ctrlp);
 		if (!s) {
@@ -1032,6 +1540,45 @@ ts_bspline_interpolate_cubic_natural(const tsReal *points,
 	TS_END_TRY_RETURN(err)
 }
 
+void
+ts_int_catmull_rom_segment(const tsReal *p0,
+                           const tsReal *p1,
+                           const tsReal *p2,
+                           const tsReal *p3,
+                           size_t dim,
+                           tsReal alpha,
+                           tsReal *ctrlp) /* out: 4 control points */
+{
+	/* [https://en.wikipedia.org/wiki/
+	 * Centripetal_Catmull%E2%80%93Rom_spline] */
+	tsReal t0, t1, t2, t3; /**< Catmull-Rom knots. */
+	/* [https://stackoverflow.com/questions/30748316/
+	 * catmull-rom-interpolation-on-svg-paths/30826434#30826434] */
+	tsReal c1, c2, d1, d2, m1, m2; /**< Used to calculate derivatives. */
+	size_t d; /**< Used in for loops. */
+
+	t0 = (tsReal) 0.f;
+	t1 = t0 + (tsReal) pow(ts_distance(p0, p1, dim), alpha);
+	t2 = t1 + (tsReal) pow(ts_distance(p1, p2, dim), alpha);
+	t3 = t2 + (tsReal) pow(ts_distance(p2, p3, dim), alpha);
+
+	c1 = (t2-t1) / (t2-t0);
+	c2 = (t1-t0) / (t2-t0);
+	d1 = (t3-t2) / (t3-t1);
+	d2 = (t2-t1) / (t3-t1);
+
+	for (d = 0; d < dim; d++) {
+		m1 = (t2-t1)*(c1*(p1[d]-p0[d])/(t1-t0)
+		              + c2*(p2[d]-p1[d])/(t2-t1));
+		m2 = (t2-t1)*(d1*(p2[d]-p1[d])/(t2-t1)
+		              + d2*(p3[d]-p2[d])/(t3-t2));
+		ctrlp[(0 * dim) + d] = p1[d];
+		ctrlp[(1 * dim) + d] = p1[d] + m1/3;
+		ctrlp[(2 * dim) + d] = p2[d] - m2/3;
+		ctrlp[(3 * dim) + d] = p2[d];
+	}
+}
+
 tsError
 ts_bspline_interpolate_catmull_rom(const tsReal *points,
                                    size_t num_points,
@@ -1050,12 +1597,6 @@ ts_bspline_interpolate_catmull_rom(const tsReal *points,
 	tsReal *cr_ctrlp; /**< The points to interpolate based on `points`. */
 	size_t i, d; /**< Used in for loops. */
 	tsError err; /**< Local error handling. */
-	/* [https://en.wikipedia.org/wiki/
-	 * Centripetal_Catmull%E2%80%93Rom_spline] */
-	tsReal t0, t1, t2, t3; /**< Catmull-Rom knots. */
-	/* [https://stackoverflow.com/questions/30748316/
-	 * catmull-rom-interpolation-on-svg-paths/30826434#30826434] */
-	tsReal c1, c2, d1, d2, m1, m2; /**< Used to calculate derivatives. */
 	tsReal *p0, *p1, *p2, *p3; /**< Processed Catmull-Rom points. */
 
 	ts_int_bspline_init(spline);
@@ -1123,10 +1664,10 @@ ts_bspline_interpolate_catmull_rom(const tsReal *points,
 	/* Transform the sequence of Catmull-Rom splines. */
 	bs_ctrlp = NULL;
 	TS_TRY(try, err, status)
-		TS_CALL(try, err, ts_bspline_new(
+		TS_CALL(try, err, ts_int_bspline_new(
 		        (num_points - 3) * 4, dimension, 3,
-		        TS_BEZIERS, spline, status))
-		bs_ctrlp = ts_int_bspline_access_ctrlp(spline);
+		        TS_BEZIERS, 0, spline, status))
+		bs_ctrlp = ts_int_bspline_unshared_ctrlp(spline);
 	TS_CATCH(err)
 		free(cr_ctrlp);
 	TS_END_TRY_ROE(err)
@@ -1135,55 +1676,735 @@ ts_bspline_interpolate_catmull_rom(const tsReal *points,
 		p1 = cr_ctrlp + ((i+1) * dimension);
 		p2 = cr_ctrlp + ((i+2) * dimension);
 		p3 = cr_ctrlp + ((i+3) * dimension);
-
-		t0 = (tsReal) 0.f;
-		t1 = t0 + (tsReal) pow(ts_distance(p0, p1, dimension), alpha);
-		t2 = t1 + (tsReal) pow(ts_distance(p1, p2, dimension), alpha);
-		t3 = t2 + (tsReal) pow(ts_distance(p2, p3, dimension), alpha);
-
-		c1 = (t2-t1) / (t2-t0);
-		c2 = (t1-t0) / (t2-t0);
-		d1 = (t3-t2) / (t3-t1);
-		d2 = (t2-t1) / (t3-t1);
-
-		for (d = 0; d < dimension; d++) {
-			m1 = (t2-t1)*(c1*(p1[d]-p0[d])/(t1-t0)
-			              + c2*(p2[d]-p1[d])/(t2-t1));
-			m2 = (t2-t1)*(d1*(p2[d]-p1[d])/(t2-t1)
-			              + d2*(p3[d]-p2[d])/(t3-t2));
-			bs_ctrlp[((i*4 + 0) * dimension) + d] = p1[d];
-			bs_ctrlp[((i*4 + 1) * dimension) + d] = p1[d] + m1/3;
-			bs_ctrlp[((i*4 + 2) * dimension) + d] = p2[d] - m2/3;
-			bs_ctrlp[((i*4 + 3) * dimension) + d] = p2[d];
-		}
+		ts_int_catmull_rom_segment(p0, p1, p2, p3, dimension, alpha,
+		                           bs_ctrlp + i * 4 * dimension);
 	}
 	free(cr_ctrlp);
 	TS_RETURN_SUCCESS(status)
 }
-/*! @} */
 
+tsStreamInterp
+ts_streaminterp_init(void)
+{
+	tsStreamInterp stream;
+	ts_int_streaminterp_init(&stream);
+	return stream;
+}
 
+tsError
+ts_int_streaminterp_new(int natural,
+                        size_t dimension,
+                        size_t window,
+                        tsReal alpha,
+                        tsReal epsilon,
+                        tsStreamInterp *stream,
+                        tsStatus *status)
+{
+	const size_t cap = natural ? window + 2 : 3;
+	const size_t len = cap * dimension     /* points */
+	                   + 2 * dimension     /* aux */
+	                   + window * dimension /* d */
+	                   + window;           /* cc */
+	tsReal *cc;
+	size_t i;
+
+	ts_int_streaminterp_init(stream);
+	if (dimension == 0)
+		TS_RETURN_0(status, TS_DIM_ZERO, "unsupported dimension: 0")
+	stream->pImpl = (struct tsStreamInterpImpl *) malloc(
+		sizeof(struct tsStreamInterpImpl) + len * sizeof(tsReal));
+	if (!stream->pImpl)
+		TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	stream->pImpl->natural = natural;
+	stream->pImpl->dim = dimension;
+	stream->pImpl->window = window;
+	stream->pImpl->alpha = alpha;
+	stream->pImpl->epsilon = epsilon;
+	stream->pImpl->n_points = 0;
+	stream->pImpl->n_seen = 0;
+	stream->pImpl->n_segs = 0;
+
+	/* The coefficients of the forward sweep of the Thomas algorithm do not
+	 * depend on the points to be interpolated (a = c = 1, b = 4). */
+	cc = ts_int_streaminterp_access_cc(stream);
+	for (i = 0; i < window; i++)
+		cc[i] = 1.f / (4.f - (i > 0 ? cc[i-1] : (tsReal) 0.0));
+	TS_RETURN_SUCCESS(status)
+}
 
-/*! @name Query Functions
- *
- * @{
- */
 tsError
-ts_int_bspline_find_knot(const tsBSpline *spline,
-                         tsReal *knot, /* in: knot; out: actual knot */
-                         size_t *idx,  /* out: index of `knot' */
-                         size_t *mult, /* out: multiplicity of `knot' */
-                         tsStatus *status)
+ts_streaminterp_new_cubic_natural(size_t dimension,
+                                  size_t window,
+                                  tsStreamInterp *stream,
+                                  tsStatus *status)
 {
-	const size_t deg = ts_bspline_degree(spline);
-	const size_t num_knots = ts_bspline_num_knots(spline);
-	const tsReal *knots = ts_int_bspline_access_knots(spline);
-	tsReal min, max;
-	size_t low, high;
+	if (window < 1) window = 1;
+	return ts_int_streaminterp_new(1, dimension, window,
+	                               (tsReal) 0.0, (tsReal) 0.0,
+	                               stream, status);
+}
 
-	ts_bspline_domain(spline, &min, &max);
-	if (*knot < min) {
-		/* Avoid infinite loop (issue #222) */
+tsError
+ts_streaminterp_new_catmull_rom(size_t dimension,
+                                tsReal alpha,
+                                tsReal epsilon,
+                                tsStreamInterp *stream,
+                                tsStatus *status)
+{
+	if (alpha < (tsReal) 0.0) alpha = (tsReal) 0.0;
+	if (alpha > (tsReal) 1.0) alpha = (tsReal) 1.0;
+	return ts_int_streaminterp_new(0, dimension, 0, alpha,
+	                               (tsReal) fabs(epsilon),
+	                               stream, status);
+}
+
+void
+ts_streaminterp_free(tsStreamInterp *stream)
+{
+	if (stream->pImpl) free(stream->pImpl);
+	ts_int_streaminterp_init(stream);
+}
+
+tsError
+ts_int_streaminterp_new_segments(const tsStreamInterp *stream,
+                                 size_t num,
+                                 tsBSpline *segments,
+                                 tsStatus *status)
+{
+	tsReal *knots;
+	size_t i;
+	tsError err;
+	TS_CALL_ROE(err, ts_int_bspline_new(
+	            num * 4, stream->pImpl->dim, 3,
+	            TS_BEZIERS, 0, segments, status))
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_int_bspline_own_knots(
+		        segments, &knots, status))
+	TS_CATCH(err)
+		ts_bspline_free(segments);
+	TS_END_TRY_ROE(err)
+	/* The i'th segment of a stream has domain [i, i+1]. */
+	for (i = 0; i < (num + 1) * 4; i++)
+		knots[i] = (tsReal) (stream->pImpl->n_segs + i / 4);
+	TS_RETURN_SUCCESS(status)
+}
+
+void
+ts_int_streaminterp_solve(const tsStreamInterp *stream,
+                          size_t num,          /* >= 3 */
+                          const tsReal *right) /* B of the last point */
+{
+	const size_t dim = stream->pImpl->dim;
+	const size_t n = num - 2; /**< Number of unknowns. */
+	const tsReal *P = ts_int_streaminterp_access_points(stream);
+	const tsReal *bf = ts_int_streaminterp_access_aux(stream);
+	const tsReal *cc = ts_int_streaminterp_access_cc(stream);
+	tsReal *d = ts_int_streaminterp_access_d(stream);
+	size_t i, j;
+	tsReal rhs;
+
+	/* Solves B_{i-1} + 4 * B_i + B_{i+1} = 6 * P_i for i = 1, ..., n with
+	 * B_0 = `bf' and B_{n+1} = `right' (see Thomas algorithm). */
+	for (i = 0; i < n; i++) {
+		for (j = 0; j < dim; j++) {
+			rhs = 6 * P[(i+1) * dim + j];
+			rhs -= i == 0 ? bf[j] : d[(i-1) * dim + j];
+			if (i == n - 1)
+				rhs -= right[j];
+			d[i * dim + j] = rhs * cc[i];
+		}
+	}
+	for (i = n-1; i > 0; i--) {
+		for (j = 0; j < dim; j++)
+			d[(i-1) * dim + j] -= cc[i-1] * d[i * dim + j];
+	}
+}
+
+void
+ts_int_streaminterp_natural_segment(const tsReal *p0,
+                                    const tsReal *p1,
+                                    const tsReal *b0,
+                                    const tsReal *b1,
+                                    size_t dim,
+                                    tsReal *ctrlp) /* out: 4 control points */
+{
+	const tsReal at = 1.f/3.f; /**< The value 'a third'. */
+	const tsReal tt = 2.f/3.f; /**< The value 'two third'. */
+	size_t d;
+	for (d = 0; d < dim; d++) {
+		ctrlp[(0 * dim) + d] = p0[d];
+		ctrlp[(1 * dim) + d] = tt*b0[d] + at*b1[d];
+		ctrlp[(2 * dim) + d] = at*b0[d] + tt*b1[d];
+		ctrlp[(3 * dim) + d] = p1[d];
+	}
+}
+
+void
+ts_int_streaminterp_push_natural(tsStreamInterp *stream,
+                                 const tsReal *point,
+                                 tsReal **ctrlp) /* in/out: next segment */
+{
+	struct tsStreamInterpImpl *impl = stream->pImpl;
+	const size_t dim = impl->dim;
+	const size_t sof_ctrlp = dim * sizeof(tsReal);
+	tsReal *P = ts_int_streaminterp_access_points(stream);
+	tsReal *bf = ts_int_streaminterp_access_aux(stream);
+	tsReal *d = ts_int_streaminterp_access_d(stream);
+
+	memcpy(P + impl->n_points * dim, point, sof_ctrlp);
+	impl->n_points++;
+	impl->n_seen++;
+	if (impl->n_seen == 1) /* Natural end condition: B_0 = P_0. */
+		memcpy(bf, point, sof_ctrlp);
+	if (impl->n_points < impl->window + 2)
+		return;
+
+	/* The window is full. Use the last point as estimate of its B-Spline
+	 * control point, fix the first unknown, and emit its segment. */
+	ts_int_streaminterp_solve(stream, impl->n_points,
+	                          P + (impl->n_points - 1) * dim);
+	ts_int_streaminterp_natural_segment(P, P + dim, bf, d, dim, *ctrlp);
+	*ctrlp += 4 * dim;
+	memcpy(bf, d, sof_ctrlp);
+	memmove(P, P + dim, (impl->n_points - 1) * sof_ctrlp);
+	impl->n_points--;
+}
+
+void
+ts_int_streaminterp_push_catmull_rom(tsStreamInterp *stream,
+                                     const tsReal *point,
+                                     tsReal **ctrlp) /* in/out */
+{
+	struct tsStreamInterpImpl *impl = stream->pImpl;
+	const size_t dim = impl->dim;
+	const size_t sof_ctrlp = dim * sizeof(tsReal);
+	tsReal *P = ts_int_streaminterp_access_points(stream);
+	tsReal *first = ts_int_streaminterp_access_aux(stream);
+	const tsReal *p0;
+	size_t n = impl->n_points;
+	size_t d;
+
+	/* Skip redundant points. */
+	if (n > 0 && ts_distance(P + (n-1) * dim, point, dim)
+	             <= impl->epsilon)
+		return;
+	if (n >= 2) {
+		if (n == 3) {
+			p0 = P;
+		} else { /* generate first point */
+			for (d = 0; d < dim; d++)
+				first[d] = P[d] + (P[d] - P[dim + d]);
+			p0 = first;
+		}
+		ts_int_catmull_rom_segment(p0, P + (n-2) * dim,
+		                           P + (n-1) * dim, point,
+		                           dim, impl->alpha, *ctrlp);
+		*ctrlp += 4 * dim;
+	}
+	if (n == 3) {
+		memmove(P, P + dim, 2 * sof_ctrlp);
+		n--;
+	}
+	memcpy(P + n * dim, point, sof_ctrlp);
+	impl->n_points = n + 1;
+	impl->n_seen++;
+}
+
+tsError
+ts_streaminterp_push(tsStreamInterp *stream,
+                     const tsReal *points,
+                     size_t num_points,
+                     tsBSpline *segments,
+                     size_t *num_segments,
+                     tsStatus *status)
+{
+	struct tsStreamInterpImpl *impl = stream->pImpl;
+	const size_t dim = impl->dim;
+	const size_t cap = impl->window + 1;
+	const tsReal *last; /**< Last accepted point (Catmull-Rom). */
+	tsReal *ctrlp = NULL;
+	size_t i, seen, num;
+	tsError err;
+
+	ts_int_bspline_init(segments);
+	*num_segments = 0;
+
+	/* Count the segments finalized by `points'. */
+	if (impl->natural) {
+		num = impl->n_points + num_points > cap
+			? impl->n_points + num_points - cap : 0;
+	} else {
+		last = impl->n_points > 0
+			? ts_int_streaminterp_access_points(stream) +
+			  (impl->n_points - 1) * dim
+			: NULL;
+		seen = impl->n_seen;
+		for (i = 0; i < num_points; i++) {
+			if (last && ts_distance(last, points + i * dim, dim)
+			            <= impl->epsilon)
+				continue;
+			last = points + i * dim;
+			seen++;
+		}
+		/* A segment is finalized with each point, starting with the
+		 * third one. */
+		num = (seen > 2 ? seen - 2 : 0) -
+		      (impl->n_seen > 2 ? impl->n_seen - 2 : 0);
+	}
+	if (num > 0) {
+		TS_CALL_ROE(err, ts_int_streaminterp_new_segments(
+		            stream, num, segments, status))
+		ctrlp = ts_int_bspline_unshared_ctrlp(segments);
+	}
+
+	for (i = 0; i < num_points; i++) {
+		if (impl->natural) {
+			ts_int_streaminterp_push_natural(
+				stream, points + i * dim, &ctrlp);
+		} else {
+			ts_int_streaminterp_push_catmull_rom(
+				stream, points + i * dim, &ctrlp);
+		}
+	}
+	impl->n_segs += num;
+	*num_segments = num;
+	TS_RETURN_SUCCESS(status)
+}
+
+tsError
+ts_streaminterp_finish(tsStreamInterp *stream,
+                       tsBSpline *segments,
+                       size_t *num_segments,
+                       tsStatus *status)
+{
+	struct tsStreamInterpImpl *impl = stream->pImpl;
+	const size_t dim = impl->dim;
+	const size_t n = impl->n_points;
+	const tsReal *P = ts_int_streaminterp_access_points(stream);
+	tsReal *aux = ts_int_streaminterp_access_aux(stream);
+	const tsReal *d = ts_int_streaminterp_access_d(stream);
+	const tsReal *b0, *b1, *p0;
+	tsReal *ctrlp;
+	size_t i, j, num;
+	tsError err;
+
+	ts_int_bspline_init(segments);
+	*num_segments = 0;
+	if (impl->n_seen == 0)
+		TS_RETURN_0(status, TS_NUM_POINTS, "num(points) == 0")
+	if (impl->n_seen == 1) {
+		TS_CALL_ROE(err, ts_int_cubic_point(
+		            P, dim, segments, status))
+		num = 1;
+	} else {
+		num = impl->natural ? n - 1 : 1;
+		TS_CALL_ROE(err, ts_int_streaminterp_new_segments(
+		            stream, num, segments, status))
+		ctrlp = ts_int_bspline_unshared_ctrlp(segments);
+		if (impl->natural) {
+			/* Natural end condition: B_n = P_n. */
+			if (n >= 3) {
+				ts_int_streaminterp_solve(
+					stream, n, P + (n-1) * dim);
+			}
+			for (i = 0; i < num; i++) {
+				b0 = i == 0 ? aux : d + (i-1) * dim;
+				b1 = i == num-1 ? P + (n-1) * dim
+				                : d + i * dim;
+				ts_int_streaminterp_natural_segment(
+					P + i * dim, P + (i+1) * dim,
+					b0, b1, dim, ctrlp + i * 4 * dim);
+			}
+		} else {
+			/* Generate first (if necessary) and last point. */
+			if (n == 3) {
+				p0 = P;
+			} else {
+				for (j = 0; j < dim; j++)
+					aux[j] = P[j] + (P[j] - P[dim + j]);
+				p0 = aux;
+			}
+			for (j = 0; j < dim; j++) {
+				aux[dim + j] = P[(n-1) * dim + j] +
+				               (P[(n-1) * dim + j] -
+				                P[(n-2) * dim + j]);
+			}
+			ts_int_catmull_rom_segment(
+				p0, P + (n-2) * dim, P + (n-1) * dim,
+				aux + dim, dim, impl->alpha, ctrlp);
+		}
+	}
+	*num_segments = num;
+	impl->n_points = 0;
+	impl->n_seen = 0;
+	impl->n_segs = 0;
+	TS_RETURN_SUCCESS(status)
+}
+
+int
+ts_int_band_cholesky(tsReal *band, /* in: lower band of A; out: L */
+                     size_t num,   /* order of A */
+                     size_t bw,    /* half bandwidth of A */
+                     size_t dim,   /* number of right-hand sides */
+                     tsReal *rhs)  /* in: b (num x dim); out: x */
+{
+	/* Solves A * x = b with A = L * L^T. Element (i, j) (with j <= i and
+	 * i - j <= bw) of A and L is stored at band[i * (bw+1) + j + bw - i].
+	 * Returns 0 if A is not (numerically) positive definite. */
+	const size_t w = bw + 1;
+	size_t i, j, k, k0, d;
+	tsReal sum, diag;
+
+	for (i = 0; i < num; i++) {
+		k0 = i > bw ? i - bw : 0;
+		for (j = k0; j <= i; j++) {
+			sum = band[i*w + j + bw - i];
+			for (k = k0; k < j; k++) {
+				sum -= band[i*w + k + bw - i] *
+				       band[j*w + k + bw - j];
+			}
+			if (i == j) {
+				diag = band[i*w + bw];
+				if (sum <= diag * (tsReal) 1e-6)
+					return 0;
+				band[i*w + bw] = (tsReal) sqrt(sum);
+			} else {
+				band[i*w + j + bw - i] = sum / band[j*w + bw];
+			}
+		}
+	}
+	/* Forward substitution (L * y = b). */
+	for (i = 0; i < num; i++) {
+		k0 = i > bw ? i - bw : 0;
+		for (d = 0; d < dim; d++) {
+			sum = rhs[i*dim + d];
+			for (k = k0; k < i; k++)
+				sum -= band[i*w + k + bw - i] * rhs[k*dim + d];
+			rhs[i*dim + d] = sum / band[i*w + bw];
+		}
+	}
+	/* Back substitution (L^T * x = y). */
+	for (i = num; i-- > 0;) {
+		for (d = 0; d < dim; d++) {
+			sum = rhs[i*dim + d];
+			for (k = i + 1; k < num && k <= i + bw; k++)
+				sum -= band[k*w + i + bw - k] * rhs[k*dim + d];
+			rhs[i*dim + d] = sum / band[i*w + bw];
+		}
+	}
+	return 1;
+}
+
+int
+ts_int_approximate_fit(const tsReal *points,
+                       size_t num_points,
+                       size_t dim,
+                       const tsReal *u,     /* parameters of `points' */
+                       const tsReal *knots, /* clamped */
+                       size_t deg,
+                       size_t n,            /* number of control points */
+                       tsReal *ws,          /* basis function workspace */
+                       tsReal *band,        /* (n-2) x (deg+1) */
+                       tsReal *rhs,         /* (n-2) x dim */
+                       tsReal *r,           /* dim */
+                       tsReal *ctrlp)       /* out: n x dim */
+{
+	/* Least squares fit with fixed end points (see 'The NURBS Book',
+	 * Section 9.4.1). Writes `ctrlp' only if the normal equations could
+	 * be solved (return value 1). */
+	const size_t order = deg + 1;
+	const size_t m = n - 2; /**< Number of unknown control points. */
+	const tsReal *q0 = points;
+	const tsReal *qn = points + (num_points - 1) * dim;
+	tsReal *basis = ws + order*order + 4*order;
+	size_t i, j, k, a, b, s, d;
+
+	ts_arr_fill(band, m * order, (tsReal) 0.0);
+	ts_arr_fill(rhs, m * dim, (tsReal) 0.0);
+	s = deg;
+	for (k = 1; k < num_points - 1; k++) {
+		while (s < n - 1 && u[k] >= knots[s + 1])
+			s++;
+		ts_int_basis_ders(knots, deg, s, u[k], 0, ws, basis);
+		/* Remove the contribution of the fixed control points. */
+		for (d = 0; d < dim; d++) {
+			r[d] = points[k*dim + d];
+			if (s == deg)
+				r[d] -= basis[0] * q0[d];
+			if (s == n - 1)
+				r[d] -= basis[deg] * qn[d];
+		}
+		for (a = 0; a <= deg; a++) {
+			i = s - deg + a;
+			if (i == 0 || i == n - 1)
+				continue;
+			for (b = 0; b <= a; b++) {
+				j = s - deg + b;
+				if (j == 0)
+					continue;
+				band[(i-1)*order + j + deg - i] +=
+					basis[a] * basis[b];
+			}
+			for (d = 0; d < dim; d++)
+				rhs[(i-1)*dim + d] += basis[a] * r[d];
+		}
+	}
+	if (m > 0 && !ts_int_band_cholesky(band, m, deg, dim, rhs))
+		return 0;
+	memcpy(ctrlp, q0, dim * sizeof(tsReal));
+	memcpy(ctrlp + dim, rhs, m * dim * sizeof(tsReal));
+	memcpy(ctrlp + (n-1) * dim, qn, dim * sizeof(tsReal));
+	return 1;
+}
+
+tsReal
+ts_int_approximate_error(const tsReal *points,
+                         size_t num_points,
+                         size_t dim,
+                         const tsReal *u,
+                         const tsReal *knots,
+                         size_t deg,
+                         size_t n,
+                         const tsReal *ctrlp,
+                         tsReal *ws,
+                         tsReal *r,
+                         tsReal *errors) /* out: max error per span */
+{
+	const size_t order = deg + 1;
+	tsReal *basis = ws + order*order + 4*order;
+	tsReal e, max = (tsReal) 0.0;
+	size_t k, a, s, d;
+
+	ts_arr_fill(errors, n, (tsReal) 0.0);
+	s = deg;
+	for (k = 0; k < num_points; k++) {
+		while (s < n - 1 && u[k] >= knots[s + 1])
+			s++;
+		ts_int_basis_ders(knots, deg, s, u[k], 0, ws, basis);
+		ts_arr_fill(r, dim, (tsReal) 0.0);
+		for (a = 0; a <= deg; a++) {
+			for (d = 0; d < dim; d++) {
+				r[d] += basis[a] *
+				        ctrlp[(s - deg + a) * dim + d];
+			}
+		}
+		e = ts_distance(r, points + k*dim, dim);
+		if (e > errors[s]) errors[s] = e;
+		if (e > max) max = e;
+	}
+	return max;
+}
+
+size_t
+ts_int_approximate_refine(const tsReal *u,
+                          size_t num_points,
+                          const tsReal *knots,
+                          size_t deg,
+                          size_t n,
+                          size_t max_insert,
+                          const tsReal *errors,
+                          tsReal tolerance,
+                          tsReal *next) /* out: refined knots */
+{
+	/* Inserts a knot into each span whose error exceeds `tolerance' and
+	 * which contains enough points to keep the normal equations solvable.
+	 * The new knot splits the points of the span in half. */
+	const size_t order = deg + 1;
+	size_t s, a, c, mid, j, num = 0;
+	tsReal knot;
+
+	memcpy(next, knots, order * sizeof(tsReal));
+	j = order;
+	a = 0;
+	for (s = deg; s < n; s++) {
+		/* The points of span `s' are [a, c). */
+		for (c = a; c < num_points &&
+		     (s == n - 1 || u[c] < knots[s + 1]); c++);
+		if (errors[s] > tolerance && c - a >= order &&
+		    num < max_insert) {
+			mid = a + (c - a) / 2;
+			knot = (u[mid - 1] + u[mid]) / 2;
+			if (!(u[a] < knot && knot <= u[c - 1]))
+				knot = (knots[s] + knots[s + 1]) / 2;
+			if (u[a] < knot && knot <= u[c - 1] &&
+			    !ts_knots_equal(knot, knots[s]) &&
+			    !ts_knots_equal(knot, knots[s + 1])) {
+				next[j++] = knot;
+				num++;
+			}
+		}
+		if (s < n - 1)
+			next[j++] = knots[s + 1];
+		a = c;
+	}
+	memcpy(next + j, knots + n, order * sizeof(tsReal));
+	return num;
+}
+
+tsError
+ts_bspline_approximate(const tsReal *points,
+                       size_t num_points,
+                       size_t dimension,
+                       size_t degree,
+                       tsReal tolerance,
+                       tsBSpline *spline,
+                       tsReal *max_error,
+                       tsReal *compression,
+                       tsStatus *status)
+{
+	const size_t dim = dimension;
+	size_t deg, order;  /**< Degree and order of `spline'. */
+	size_t max_ctrlp;   /**< Upper bound of control points. */
+	size_t n;           /**< Current number of control points. */
+	size_t num;         /**< Number of knots to insert. */
+	tsReal *buffer = NULL;
+	tsReal *u;          /**< Chord length parameters of `points'. */
+	tsReal *knots;      /**< Current knots. */
+	tsReal *next;       /**< Refined knots. */
+	tsReal *swap;       /**< Used to swap `knots' and `next'. */
+	tsReal *ctrlp;      /**< Current control points. */
+	tsReal *band;       /**< Normal equations (lower band). */
+	tsReal *rhs;        /**< Right-hand side of normal equations. */
+	tsReal *errors;     /**< Maximum error per span. */
+	tsReal *ws;         /**< Basis functions workspace. */
+	tsReal *r;          /**< A single point. */
+	tsReal len, max;
+	size_t i, k;
+	tsError err;
+
+	ts_int_bspline_init(spline);
+	if (dim == 0)
+		TS_RETURN_0(status, TS_DIM_ZERO, "unsupported dimension: 0")
+	if (num_points == 0)
+		TS_RETURN_0(status, TS_NUM_POINTS, "num(points) == 0")
+	deg = degree < 1 ? 1 : degree;
+	order = deg + 1;
+	if (num_points < order) {
+		TS_RETURN_2(status, TS_DEG_GE_NCTRLP,
+		            "degree (%lu) >= num(points) (%lu)",
+		            (unsigned long) deg,
+		            (unsigned long) num_points)
+	}
+	tolerance = (tsReal) fabs(tolerance);
+	max_ctrlp = num_points;
+	if (max_ctrlp + order > TS_MAX_NUM_KNOTS)
+		max_ctrlp = TS_MAX_NUM_KNOTS - order;
+
+	buffer = (tsReal *) malloc(sizeof(tsReal) * (
+		num_points +                      /* u */
+		2 * (max_ctrlp + order) +         /* knots, next */
+		max_ctrlp * dim +                 /* ctrlp */
+		max_ctrlp * order +               /* band */
+		max_ctrlp * dim +                 /* rhs */
+		max_ctrlp +                       /* errors */
+		order*order + 4*order + order +   /* ws (incl. basis) */
+		dim));                            /* r */
+	if (!buffer)
+		TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	u = buffer;
+	knots = u + num_points;
+	next = knots + max_ctrlp + order;
+	ctrlp = next + max_ctrlp + order;
+	band = ctrlp + max_ctrlp * dim;
+	rhs = band + max_ctrlp * order;
+	errors = rhs + max_ctrlp * dim;
+	ws = errors + max_ctrlp;
+	r = ws + order*order + 4*order + order;
+
+	TS_TRY(try, err, status)
+		/* Chord length parameterization. */
+		u[0] = (tsReal) 0.0;
+		for (k = 1; k < num_points; k++) {
+			u[k] = u[k-1] + ts_distance(points + (k-1) * dim,
+			                            points + k * dim, dim);
+		}
+		len = u[num_points - 1];
+		for (k = 1; k < num_points; k++) {
+			u[k] = len > (tsReal) 0.0
+				? u[k] / len
+				: (tsReal) k / (num_points - 1);
+		}
+		u[num_points - 1] = (tsReal) 1.0;
+
+		/* Start with a single bezier curve. */
+		n = order;
+		for (i = 0; i < order; i++) {
+			knots[i] = (tsReal) 0.0;
+			knots[order + i] = (tsReal) 1.0;
+		}
+		if (!ts_int_approximate_fit(points, num_points, dim, u,
+		                            knots, deg, n, ws, band, rhs,
+		                            r, ctrlp)) {
+			TS_THROW_0(try, err, status, TS_NO_RESULT,
+			           "normal equations are singular")
+		}
+		max = ts_int_approximate_error(points, num_points, dim, u,
+		                               knots, deg, n, ctrlp, ws, r,
+		                               errors);
+
+		/* Insert knots until `tolerance' is met or the spans cannot
+		 * be refined any further. */
+		while (max > tolerance) {
+			num = ts_int_approximate_refine(u, num_points, knots,
+			                                deg, n, max_ctrlp - n,
+			                                errors, tolerance,
+			                                next);
+			if (num == 0)
+				break;
+			if (!ts_int_approximate_fit(points, num_points, dim,
+			                            u, next, deg, n + num, ws,
+			                            band, rhs, r, ctrlp))
+				break; /* keep the previous fit */
+			swap = knots;
+			knots = next;
+			next = swap;
+			n += num;
+			max = ts_int_approximate_error(points, num_points,
+			                               dim, u, knots, deg, n,
+			                               ctrlp, ws, r, errors);
+		}
+
+		TS_CALL(try, err, ts_int_bspline_new(
+		        n, dim, deg, TS_CLAMPED, 0, spline, status))
+		memcpy(ts_int_bspline_unshared_ctrlp(spline), ctrlp,
+		       ts_bspline_sof_control_points(spline));
+		TS_CALL(try, err, ts_int_bspline_own_knots(
+		        spline, &swap, status))
+		memcpy(swap, knots, ts_bspline_sof_knots(spline));
+		if (max_error)
+			*max_error = max;
+		if (compression)
+			*compression = (tsReal) num_points / n;
+	TS_CATCH(err)
+		ts_bspline_free(spline);
+	TS_FINALLY
+		free(buffer);
+	TS_END_TRY_RETURN(err)
+}
+/*! @} */
+
+
+
+/*! @name Query Functions
+ *
+ * @{
+ */
+tsError
+ts_int_bspline_find_knot(const tsBSpline *spline,
+                         tsReal *knot, /* in: knot; out: actual knot */
+                         size_t *idx,  /* out: index of `knot' */
+                         size_t *mult, /* out: multiplicity of `knot' */
+                         tsStatus *status)
+{
+	const size_t deg = ts_bspline_degree(spline);
+	const size_t num_knots = ts_bspline_num_knots(spline);
+	const tsReal *knots = ts_int_bspline_access_knots(spline);
+	tsReal min, max;
+	size_t low, high;
+
+	ts_bspline_domain(spline, &min, &max);
+	if (*knot < min) {
+		/* Avoid infinite loop (issue #222) */
 		if (ts_knots_equal(*knot, min)) *knot = min;
 		else {
 			TS_RETURN_2(status, TS_U_UNDEFINED,
@@ -1334,6 +2555,222 @@ ts_int_bspline_eval_woa(const tsBSpline *spline,
 	TS_RETURN_SUCCESS(status)
 }
 
+tsError
+ts_int_bspline_find_span(const tsBSpline *spline,
+                         tsReal *knot, /* in: knot; out: actual knot */
+                         size_t *span, /* out: index of the knot span */
+                         tsStatus *status)
+{
+	const size_t num_ctrlp = ts_bspline_num_control_points(spline);
+	size_t mult;
+	tsError err;
+	TS_CALL_ROE(err, ts_int_bspline_find_knot(
+	            spline, knot, span, &mult, status))
+	/* If `knot' is the maximum of the domain, `ts_int_bspline_find_knot'
+	 * returns an index that is beyond the last non-empty knot span
+	 * [u_{n-1}, u_n), where n is the number of control points. The basis
+	 * functions, however, must be evaluated in the last non-empty span. */
+	if (*span > num_ctrlp - 1)
+		*span = num_ctrlp - 1;
+	TS_RETURN_SUCCESS(status)
+}
+
+tsError
+ts_int_bspline_find_left_span(const tsBSpline *spline,
+                              tsReal *knot, /* in: knot; out: actual knot */
+                              size_t *span, /* out: index of the knot span */
+                              tsStatus *status)
+{
+	const size_t deg = ts_bspline_degree(spline);
+	const size_t num_ctrlp = ts_bspline_num_control_points(spline);
+	size_t idx, mult;
+	tsError err;
+	TS_CALL_ROE(err, ts_int_bspline_find_knot(
+	            spline, knot, &idx, &mult, status))
+	/* At an interior knot whose multiplicity is at least the degree of
+	 * `spline', the first derivative (and, if the multiplicity equals the
+	 * order, the point) may jump. Evaluate the span ending at `knot' in
+	 * this case, which yields the left-hand limits---the values that
+	 * `ts_int_deboornet_access_result' selects from a DeBoor net. */
+	if (mult >= deg && idx >= deg + mult)
+		*span = idx - mult;
+	else
+		*span = idx;
+	if (*span > num_ctrlp - 1)
+		*span = num_ctrlp - 1;
+	TS_RETURN_SUCCESS(status)
+}
+
+size_t
+ts_int_bspline_len_derivs_ws(const tsBSpline *spline,
+                             size_t n)
+{
+	const size_t deg = ts_bspline_degree(spline);
+	const size_t order = ts_bspline_order(spline);
+	const size_t du = n < deg ? n : deg;
+	/* `ndu' (order * order), `left' and `right' (order each), the two rows
+	 * of `a' (order each), and the derivatives of the basis functions
+	 * ((du + 1) * order). */
+	return order * order + 4 * order + (du + 1) * order;
+}
+
+tsError
+ts_int_bspline_eval_derivs_woa(const tsBSpline *spline,
+                               tsReal u,
+                               size_t n,
+                               tsReal *ws,
+                               tsReal *derivs,
+                               tsStatus *status)
+{
+	const size_t deg = ts_bspline_degree(spline);
+	const size_t order = ts_bspline_order(spline);
+	const size_t dim = ts_bspline_dimension(spline);
+	const size_t du = n < deg ? n : deg; /**< Non-vanishing derivatives. */
+	const tsReal *ctrlp = ts_int_bspline_access_ctrlp(spline);
+	const tsReal *knots = ts_int_bspline_access_knots(spline);
+	tsReal *ders = ws + order*order + 4*order; /**< See `ws' layout. */
+	const tsReal *P; /**< First affected control point. */
+	size_t span, k, j, d;
+	tsReal N;
+	tsError err;
+
+	/* Left-hand limits at discontinuities, just like `ts_bspline_eval'. */
+	TS_CALL_ROE(err, ts_int_bspline_find_left_span(
+	            spline, &u, &span, status))
+	ts_int_basis_ders(knots, deg, span, u, du, ws, ders);
+
+	ts_arr_fill(derivs, (n+1) * dim, (tsReal) 0.0);
+	P = ctrlp + (span-deg) * dim; /* span >= deg */
+	for (k = 0; k <= du; k++) {
+		for (j = 0; j < order; j++) {
+			N = ders[k*order + j];
+			for (d = 0; d < dim; d++)
+				derivs[k*dim + d] += N * P[j*dim + d];
+		}
+	}
+	TS_RETURN_SUCCESS(status)
+}
+
+size_t
+ts_int_bspline_len_derivs_rational_ws(const tsBSpline *spline,
+                                      size_t n)
+{
+	/* Workspace of the non-rational kernel plus the derivatives of the
+	 * homogeneous curve. */
+	return ts_int_bspline_len_derivs_ws(spline, n) +
+	       (n+1) * ts_bspline_dimension(spline);
+}
+
+tsError
+ts_int_bspline_eval_derivs_rational_woa(const tsBSpline *spline,
+                                        tsReal u,
+                                        size_t n,
+                                        tsReal *ws,
+                                        tsReal *derivs,
+                                        tsStatus *status)
+{
+	/* Based on algorithm A4.2 of 'The NURBS Book' (Les Piegl and Wayne
+	 * Tiller). The caller must ensure that the dimensionality of `spline'
+	 * is at least 2. */
+	const size_t dim = ts_bspline_dimension(spline);
+	const size_t cdim = dim - 1; /**< Dimensionality of the projection. */
+	/** Derivatives of the homogeneous curve (A^(k) and w^(k)). */
+	tsReal *hders = ws + ts_int_bspline_len_derivs_ws(spline, n);
+	tsReal v;   /**< The k'th derivative of the current component. */
+	tsReal bin; /**< Binomial coefficient (k over i). */
+	tsReal w;   /**< Weight at `u'. */
+	size_t k, i, d;
+	tsError err;
+
+	TS_CALL_ROE(err, ts_int_bspline_eval_derivs_woa(
+	            spline, u, n, ws, hders, status))
+	w = hders[cdim];
+	for (k = 0; k <= n; k++) {
+		for (d = 0; d < cdim; d++) {
+			v = hders[k*dim + d];
+			bin = (tsReal) 1.0;
+			for (i = 1; i <= k; i++) {
+				bin = bin * (tsReal) (k-i+1) / (tsReal) i;
+				v -= bin * hders[i*dim + cdim] *
+				     derivs[(k-i)*cdim + d];
+			}
+			derivs[k*cdim + d] = v / w;
+		}
+	}
+	TS_RETURN_SUCCESS(status)
+}
+
+tsReal
+ts_int_speed(const tsReal *derivs,
+             size_t dim)
+{
+	return ts_vec_mag(derivs + dim, dim);
+}
+
+tsReal
+ts_int_curvature(const tsReal *derivs,
+                 size_t dim)
+{
+	const tsReal *d1 = derivs + dim;
+	const tsReal *d2 = derivs + 2*dim;
+	const tsReal speed = ts_vec_mag(d1, dim);
+	tsReal dot, area;
+	if (speed < TS_LENGTH_ZERO)
+		return (tsReal) 0.0;
+	dot = ts_vec_dot(d1, d2, dim);
+	/* Lagrange's identity: |d1 x d2|^2 = |d1|^2 |d2|^2 - (d1 . d2)^2 */
+	area = speed * speed * ts_vec_dot(d2, d2, dim) - dot * dot;
+	/* Avoid sqrt of negative values due to floating point errors. */
+	if (area < (tsReal) 0.0)
+		area = (tsReal) 0.0;
+	return (tsReal) sqrt(area) / (speed * speed * speed);
+}
+
+tsReal
+ts_int_torsion(const tsReal *derivs,
+               size_t dim)
+{
+	tsReal d1[3], d2[3], d3[3], c[3], mag;
+	ts_vec3_set(d1, derivs + dim, dim);
+	ts_vec3_set(d2, derivs + 2*dim, dim);
+	ts_vec3_set(d3, derivs + 3*dim, dim);
+	ts_vec3_cross(d1, d2, c);
+	mag = ts_vec_mag(c, 3);
+	if (mag < TS_LENGTH_ZERO)
+		return (tsReal) 0.0;
+	return ts_vec_dot(c, d3, 3) / (mag * mag);
+}
+
+tsError
+ts_int_bspline_eval_measure(const tsBSpline *spline,
+                            const tsReal *knots,
+                            size_t num,
+                            size_t n,
+                            tsReal (*measure)(const tsReal *, size_t),
+                            tsReal *values,
+                            tsStatus *status)
+{
+	const size_t dim = ts_bspline_dimension(spline);
+	const size_t len_ws = ts_int_bspline_len_derivs_ws(spline, n);
+	tsReal *ws, *derivs;
+	size_t i;
+	tsError err;
+
+	if (num == 0) TS_RETURN_SUCCESS(status)
+	ws = (tsReal *) malloc((len_ws + (n+1) * dim) * sizeof(tsReal));
+	if (!ws) TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	derivs = ws + len_ws;
+	TS_TRY(try, err, status)
+		for (i = 0; i < num; i++) {
+			TS_CALL(try, err, ts_int_bspline_eval_derivs_woa(
+			        spline, knots[i], n, ws, derivs, status))
+			values[i] = measure(derivs, dim);
+		}
+	TS_FINALLY
+		free(ws);
+	TS_END_TRY_RETURN(err)
+}
+
 tsError
 ts_bspline_eval(const tsBSpline *spline,
                 tsReal knot,
@@ -1352,6 +2789,71 @@ ts_bspline_eval(const tsBSpline *spline,
 	TS_END_TRY_RETURN(err)
 }
 
+void
+ts_int_sink_store(const tsSink *sink,
+                  size_t i,
+                  const tsReal *point,
+                  size_t dim)
+{
+	const size_t size = sink->type == TS_SINK_FLOAT ? sizeof(float)
+		: sink->type == TS_SINK_DOUBLE ? sizeof(double)
+		: sizeof(tsReal);
+	const size_t stride = sink->stride ? sink->stride : sink->dim * size;
+	char *out = (char *) sink->data + sink->offset + i * stride;
+	size_t d;
+	tsReal v;
+	for (d = 0; d < sink->dim; d++) {
+		v = d < dim ? point[d] : (tsReal) 0.0;
+		if (sink->type == TS_SINK_FLOAT)
+			((float *) out)[d] = (float) v;
+		else if (sink->type == TS_SINK_DOUBLE)
+			((double *) out)[d] = (double) v;
+		else
+			((tsReal *) out)[d] = v;
+	}
+}
+
+tsReal
+ts_int_uniform_knot(tsReal min,
+                    tsReal max,
+                    size_t i,
+                    size_t num)
+{
+	/* Same as `knots[i]' of ::ts_bspline_uniform_knot_seq. */
+	tsReal knot;
+	if (i == 0) return min;
+	if (i == num - 1) return max;
+	knot = max - min;
+	knot *= (tsReal) i / (num - 1);
+	return knot + min;
+}
+
+tsError
+ts_bspline_eval_all_sink(const tsBSpline *spline,
+                         const tsReal *knots,
+                         size_t num,
+                         const tsSink *sink,
+                         tsStatus *status)
+{
+	const size_t dim = ts_bspline_dimension(spline);
+	tsDeBoorNet net = ts_deboornet_init();
+	size_t i;
+	tsError err;
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_int_deboornet_new(
+		        spline, &net, status))
+		for (i = 0; i < num; i++) {
+			TS_CALL(try, err, ts_int_bspline_eval_woa(
+			        spline, knots[i], &net, status))
+			ts_int_sink_store(sink, i,
+			                  ts_int_deboornet_access_result(&net),
+			                  dim);
+		}
+	TS_FINALLY
+		ts_deboornet_free(&net);
+	TS_END_TRY_RETURN(err)
+}
+
 tsError
 ts_bspline_eval_all(const tsBSpline *spline,
                     const tsReal *knots,
@@ -1360,11 +2862,8 @@ ts_bspline_eval_all(const tsBSpline *spline,
                     tsStatus *status)
 {
 	const size_t dim = ts_bspline_dimension(spline);
-	const size_t sof_point = dim * sizeof(tsReal);
-	const size_t sof_points = num * sof_point;
-	tsDeBoorNet net = ts_deboornet_init();
-	tsReal *result;
-	size_t i;
+	const size_t sof_points = num * dim * sizeof(tsReal);
+	tsSink sink;
 	tsError err;
 	TS_TRY(try, err, status)
 		*points = (tsReal *) malloc(sof_points);
@@ -1372,20 +2871,17 @@ ts_bspline_eval_all(const tsBSpline *spline,
 			TS_THROW_0(try, err, status, TS_MALLOC,
 			           "out of memory")
 		}
-		TS_CALL(try, err, ts_int_deboornet_new(
-		        spline,&net, status))
-		for (i = 0; i < num; i++) {
-			TS_CALL(try, err, ts_int_bspline_eval_woa(
-			        spline, knots[i], &net, status))
-			result = ts_int_deboornet_access_result(&net);
-			memcpy((*points) + i * dim, result, sof_point);
-		}
+		sink.data = *points;
+		sink.offset = 0;
+		sink.stride = 0;
+		sink.dim = dim;
+		sink.type = TS_SINK_REAL;
+		TS_CALL(try, err, ts_bspline_eval_all_sink(
+		        spline, knots, num, &sink, status))
 	TS_CATCH(err)
 		if (*points)
 			free(*points);
 		*points = NULL;
-	TS_FINALLY
-		ts_deboornet_free(&net);
 	TS_END_TRY_RETURN(err)
 }
 
@@ -1415,6 +2911,207 @@ ts_bspline_sample(const tsBSpline *spline,
 	TS_END_TRY_RETURN(err)
 }
 
+tsError
+ts_bspline_sample_sink(const tsBSpline *spline,
+                       size_t num,
+                       const tsSink *sink,
+                       tsStatus *status)
+{
+	const size_t dim = ts_bspline_dimension(spline);
+	tsDeBoorNet net = ts_deboornet_init();
+	tsReal min, max;
+	size_t i;
+	tsError err;
+
+	if (num == 0) TS_RETURN_SUCCESS(status)
+	ts_bspline_domain(spline, &min, &max);
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_int_deboornet_new(
+		        spline, &net, status))
+		for (i = 0; i < num; i++) {
+			TS_CALL(try, err, ts_int_bspline_eval_woa(
+			        spline, ts_int_uniform_knot(min, max, i, num),
+			        &net, status))
+			ts_int_sink_store(sink, i,
+			                  ts_int_deboornet_access_result(&net),
+			                  dim);
+		}
+	TS_FINALLY
+		ts_deboornet_free(&net);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_bspline_eval_derivs(const tsBSpline *spline,
+                       tsReal knot,
+                       size_t n,
+                       tsReal *derivs,
+                       tsStatus *status)
+{
+	return ts_bspline_eval_derivs_all(spline, &knot, 1, n, derivs, status);
+}
+
+tsError
+ts_bspline_eval_derivs_all(const tsBSpline *spline,
+                           const tsReal *knots,
+                           size_t num,
+                           size_t n,
+                           tsReal *derivs,
+                           tsStatus *status)
+{
+	const size_t len_derivs = (n+1) * ts_bspline_dimension(spline);
+	tsReal *ws;
+	size_t i;
+	tsError err;
+
+	if (num == 0) TS_RETURN_SUCCESS(status)
+	ws = (tsReal *) malloc(ts_int_bspline_len_derivs_ws(spline, n) *
+	                       sizeof(tsReal));
+	if (!ws) TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	TS_TRY(try, err, status)
+		for (i = 0; i < num; i++) {
+			TS_CALL(try, err, ts_int_bspline_eval_derivs_woa(
+			        spline, knots[i], n, ws,
+			        derivs + i * len_derivs, status))
+		}
+	TS_FINALLY
+		free(ws);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_bspline_eval_derivs_rational(const tsBSpline *spline,
+                                tsReal knot,
+                                size_t n,
+                                tsReal *derivs,
+                                tsStatus *status)
+{
+	return ts_bspline_eval_derivs_all_rational(
+		spline, &knot, 1, n, derivs, status);
+}
+
+tsError
+ts_bspline_eval_derivs_all_rational(const tsBSpline *spline,
+                                    const tsReal *knots,
+                                    size_t num,
+                                    size_t n,
+                                    tsReal *derivs,
+                                    tsStatus *status)
+{
+	const size_t dim = ts_bspline_dimension(spline);
+	const size_t len_derivs = (n+1) * (dim-1);
+	tsReal *ws;
+	size_t i;
+	tsError err;
+
+	if (dim < 2) {
+		TS_RETURN_1(status, TS_DIM_ZERO,
+		            "unsupported dimension of rational spline: %lu",
+		            (unsigned long) dim)
+	}
+	if (num == 0) TS_RETURN_SUCCESS(status)
+	ws = (tsReal *) malloc(ts_int_bspline_len_derivs_rational_ws(
+	                       spline, n) * sizeof(tsReal));
+	if (!ws) TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	TS_TRY(try, err, status)
+		for (i = 0; i < num; i++) {
+			TS_CALL(try, err,
+			        ts_int_bspline_eval_derivs_rational_woa(
+			        spline, knots[i], n, ws,
+			        derivs + i * len_derivs, status))
+		}
+	TS_FINALLY
+		free(ws);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_bspline_eval_all_rational(const tsBSpline *spline,
+                             const tsReal *knots,
+                             size_t num,
+                             tsReal **points,
+                             tsStatus *status)
+{
+	const size_t dim = ts_bspline_dimension(spline);
+	tsError err;
+
+	*points = NULL;
+	if (dim < 2) {
+		TS_RETURN_1(status, TS_DIM_ZERO,
+		            "unsupported dimension of rational spline: %lu",
+		            (unsigned long) dim)
+	}
+	*points = (tsReal *) malloc(num * (dim-1) * sizeof(tsReal));
+	if (!*points) TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_bspline_eval_derivs_all_rational(
+		        spline, knots, num, 0, *points, status))
+	TS_CATCH(err)
+		free(*points);
+		*points = NULL;
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_bspline_sample_rational(const tsBSpline *spline,
+                           size_t num,
+                           tsReal **points,
+                           size_t *actual_num,
+                           tsStatus *status)
+{
+	tsError err;
+	tsReal *knots;
+
+	num = num == 0 ? 100 : num;
+	*actual_num = num;
+	knots = (tsReal *) malloc(num * sizeof(tsReal));
+	if (!knots) {
+		*points = NULL;
+		TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	}
+	ts_bspline_uniform_knot_seq(spline, num, knots);
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_bspline_eval_all_rational(
+		        spline, knots, num, points, status))
+	TS_FINALLY
+		free(knots);
+	TS_END_TRY_RETURN(err)
+}
+
+tsError
+ts_bspline_speed(const tsBSpline *spline,
+                 const tsReal *knots,
+                 size_t num,
+                 tsReal *speeds,
+                 tsStatus *status)
+{
+	return ts_int_bspline_eval_measure(spline, knots, num, 1,
+	                                   ts_int_speed, speeds, status);
+}
+
+tsError
+ts_bspline_curvature(const tsBSpline *spline,
+                     const tsReal *knots,
+                     size_t num,
+                     tsReal *curvatures,
+                     tsStatus *status)
+{
+	return ts_int_bspline_eval_measure(spline, knots, num, 2,
+	                                   ts_int_curvature, curvatures,
+	                                   status);
+}
+
+tsError
+ts_bspline_torsion(const tsBSpline *spline,
+                   const tsReal *knots,
+                   size_t num,
+                   tsReal *torsions,
+                   tsStatus *status)
+{
+	return ts_int_bspline_eval_measure(spline, knots, num, 3,
+	                                   ts_int_torsion, torsions, status);
+}
+
 tsError
 ts_bspline_bisect(const tsBSpline *spline,
                   tsReal value,
@@ -1533,6 +3230,123 @@ ts_bspline_is_closed(const tsBSpline *spline,
 	TS_END_TRY_RETURN(err)
 }
 
+void
+ts_int_rmf_first(const tsReal *derivs, /* point and tangent */
+                 size_t dim,
+                 int has_first_normal,
+                 tsFrame *frame)
+{
+	tsReal fx, fy, fz, fmin;
+
+	/* Set position and tangent. */
+	ts_vec3_set(frame->position, derivs, dim);
+	ts_vec3_set(frame->tangent, derivs + dim, dim);
+	ts_vec_norm(frame->tangent, 3, frame->tangent);
+	/* Set normal. */
+	if (!has_first_normal) {
+		fx = (tsReal) fabs(frame->tangent[0]);
+		fy = (tsReal) fabs(frame->tangent[1]);
+		fz = (tsReal) fabs(frame->tangent[2]);
+		fmin = fx; /* x is min => 1, 0, 0 */
+		ts_vec3_init(frame->normal,
+		             (tsReal) 1.0,
+		             (tsReal) 0.0,
+		             (tsReal) 0.0);
+		if (fy < fmin) { /* y is min => 0, 1, 0 */
+			fmin = fy;
+			ts_vec3_init(frame->normal,
+			             (tsReal) 0.0,
+			             (tsReal) 1.0,
+			             (tsReal) 0.0);
+		}
+		if (fz < fmin) { /* z is min => 0, 0, 1 */
+			ts_vec3_init(frame->normal,
+			             (tsReal) 0.0,
+			             (tsReal) 0.0,
+			             (tsReal) 1.0);
+		}
+		ts_vec3_cross(frame->tangent,
+		              frame->normal,
+		              frame->normal);
+		ts_vec_norm(frame->normal, 3, frame->normal);
+		if (dim >= 3) {
+			/* In 3D (and higher) an additional rotation of the
+			   normal along the tangent is needed in order to let
+			   the normal extend sideways (as it does in 2D and
+			   lower). */
+			ts_vec3_cross(frame->tangent,
+			              frame->normal,
+			              frame->normal);
+		}
+	} else {
+		/* Never trust user input! */
+		ts_vec_norm(frame->normal, 3, frame->normal);
+	}
+	/* Set binormal. */
+	ts_vec3_cross(frame->tangent,
+	              frame->normal,
+	              frame->binormal);
+}
+
+void
+ts_int_rmf_next(const tsFrame *current,
+                const tsReal *derivs, /* next point and tangent */
+                size_t dim,
+                tsFrame *next)
+{
+	/* Double reflection method (see ::ts_bspline_compute_rmf). */
+	tsReal xc[3], xn[3], v1[3], c1, v2[3], c2, rL[3], tL[3];
+
+	/* The current point is the position of the current frame. */
+	ts_vec3_set(xc, /* xc is now the current point */
+	            current->position, 3);
+	ts_vec3_set(xn, /* xn is now the next point */
+	            derivs, dim);
+
+	/* Set position of U_{i+1}. */
+	ts_vec3_set(next->position, xn, 3);
+
+	/* Compute reflection vector of R_{1}. */
+	ts_vec_sub(xn, xc, 3, v1);
+	c1 = ts_vec_dot(v1, v1, 3);
+
+	/* Compute r_{i}^{L} = R_{1} * r_{i}. */
+	rL[0] = (tsReal) 2.0 / c1;
+	rL[1] = ts_vec_dot(v1, current->normal, 3);
+	rL[2] = rL[0] * rL[1];
+	ts_vec_mul(v1, 3, rL[2], rL);
+	ts_vec_sub(current->normal, rL, 3, rL);
+
+	/* Compute t_{i}^{L} = R_{1} * t_{i}. */
+	tL[0] = (tsReal) 2.0 / c1;
+	tL[1] = ts_vec_dot(v1, current->tangent, 3);
+	tL[2] = tL[0] * tL[1];
+	ts_vec_mul(v1, 3, tL[2], tL);
+	ts_vec_sub(current->tangent, tL, 3, tL);
+
+	/* Compute reflection vector of R_{2}. */
+	ts_vec3_set(xn, /* xn is now the next tangent */
+	            derivs + dim, dim);
+	ts_vec_norm(xn, 3, xn);
+	ts_vec_sub(xn, tL, 3, v2);
+	c2 = ts_vec_dot(v2, v2, 3);
+
+	/* Compute r_{i+1} = R_{2} * r_{i}^{L}. */
+	xc[0] = (tsReal) 2.0 / c2; /* xc is now the next normal */
+	xc[1] = ts_vec_dot(v2, rL, 3);
+	xc[2] = xc[0] * xc[1];
+	ts_vec_mul(v2, 3, xc[2], xc);
+	ts_vec_sub(rL, xc, 3, xc);
+	ts_vec_norm(xc, 3, xc);
+
+	/* Compute vector s_{i+1} of U_{i+1}. */
+	ts_vec3_cross(xn, xc, next->binormal);
+
+	/* Set vectors t_{i+1} and r_{i+1} of U_{i+1}. */
+	ts_vec3_set(next->tangent, xn, 3);
+	ts_vec3_set(next->normal, xc, 3);
+}
+
 tsError
 ts_bspline_compute_rmf(const tsBSpline *spline,
                        const tsReal *knots,
@@ -1541,152 +3355,183 @@ ts_bspline_compute_rmf(const tsBSpline *spline,
                        tsFrame *frames,
                        tsStatus *status)
 {
+	const size_t dim = ts_bspline_dimension(spline);
+	const size_t len_ws = ts_int_bspline_len_derivs_ws(spline, 1);
 	tsError err;
 	size_t i;
-	tsReal fx, fy, fz, fmin;
-	tsReal xc[3], xn[3], v1[3], c1, v2[3], c2, rL[3], tL[3];
-	tsBSpline deriv = ts_bspline_init();
-	tsDeBoorNet curr = ts_deboornet_init();
-	tsDeBoorNet next = ts_deboornet_init();
+	tsReal *ws = NULL; /**< Workspace of the evaluation. */
+	tsReal *derivs;    /**< Point (derivs) and tangent (derivs + dim). */
 
 	if (num < 1)
 		TS_RETURN_SUCCESS(status);
 
+	ws = (tsReal *) malloc((len_ws + 2 * dim) * sizeof(tsReal));
+	if (!ws) TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	derivs = ws + len_ws;
+
 	TS_TRY(try, err, status)
-		TS_CALL(try, err, ts_int_deboornet_new(
-		        spline, &curr, status))
-		TS_CALL(try, err, ts_int_deboornet_new(
-		        spline, &next, status))
-		TS_CALL(try, err, ts_bspline_derive(
-		        spline, 1, (tsReal) -1.0, &deriv, status))
+		TS_CALL(try, err, ts_int_bspline_eval_derivs_woa(
+		        spline, knots[0], 1, ws, derivs, status))
+		ts_int_rmf_first(derivs, dim, has_first_normal, frames);
 
-		/* Set position. */
-		TS_CALL(try, err, ts_int_bspline_eval_woa(
-		        spline, knots[0], &curr, status))
-		ts_vec3_set(frames[0].position,
-		            ts_int_deboornet_access_result(&curr),
-		            ts_bspline_dimension(spline));
-		/* Set tangent. */
-		TS_CALL(try, err, ts_int_bspline_eval_woa(
-		        &deriv, knots[0], &curr, status))
-		ts_vec3_set(frames[0].tangent,
-		            ts_int_deboornet_access_result(&curr),
-		            ts_bspline_dimension(&deriv));
-		ts_vec_norm(frames[0].tangent, 3, frames[0].tangent);
-		/* Set normal. */
-		if (!has_first_normal) {
-			fx = (tsReal) fabs(frames[0].tangent[0]);
-			fy = (tsReal) fabs(frames[0].tangent[1]);
-			fz = (tsReal) fabs(frames[0].tangent[2]);
-			fmin = fx; /* x is min => 1, 0, 0 */
-			ts_vec3_init(frames[0].normal,
-			             (tsReal) 1.0,
-			             (tsReal) 0.0,
-			             (tsReal) 0.0);
-			if (fy < fmin) { /* y is min => 0, 1, 0 */
-				fmin = fy;
-				ts_vec3_init(frames[0].normal,
-				             (tsReal) 0.0,
-				             (tsReal) 1.0,
-				             (tsReal) 0.0);
-			}
-			if (fz < fmin) { /* z is min => 0, 0, 1 */
-				ts_vec3_init(frames[0].normal,
-				             (tsReal) 0.0,
-				             (tsReal) 0.0,
-				             (tsReal) 1.0);
-			}
-			ts_vec3_cross(frames[0].tangent,
-			              frames[0].normal,
-			              frames[0].normal);
-			ts_vec_norm(frames[0].normal, 3, frames[0].normal);
-			if (ts_bspline_dimension(spline) >= 3) {
-				/* In 3D (and higher) an additional rotation of
-				   the normal along the tangent is needed in
-				   order to let the normal extend sideways (as
-				   it does in 2D and lower). */
-				ts_vec3_cross(frames[0].tangent,
-				              frames[0].normal,
-				              frames[0].normal);
+		for (i = 0; i < num - 1; i++) {
+			/* Eval next point and tangent. */
+			TS_CALL(try, err, ts_int_bspline_eval_derivs_woa(
+			        spline, knots[i+1], 1, ws, derivs, status))
+			ts_int_rmf_next(frames + i, derivs, dim, frames + i + 1);
+		}
+	TS_FINALLY
+		free(ws);
+	TS_END_TRY_RETURN(err)
+}
+
+void
+ts_int_sweep_ring(const tsFrame *frame,
+                  const tsReal *profile,
+                  const tsReal *profile_normals,
+                  size_t num_profile,
+                  size_t first, /* index of the ring's first vertex */
+                  const tsSink *vertices,
+                  const tsSink *normals)
+{
+	tsReal v[3];
+	size_t i, d;
+	for (i = 0; i < num_profile; i++) {
+		for (d = 0; d < 3; d++) {
+			v[d] = frame->position[d] +
+				profile[i*2] * frame->normal[d] +
+				profile[i*2 + 1] * frame->binormal[d];
+		}
+		ts_int_sink_store(vertices, first + i, v, 3);
+		if (!normals) continue;
+		for (d = 0; d < 3; d++) {
+			v[d] = profile_normals[i*2] * frame->normal[d] +
+				profile_normals[i*2 + 1] * frame->binormal[d];
+		}
+		ts_int_sink_store(normals, first + i, v, 3);
+	}
+}
+
+tsError
+ts_bspline_sweep(const tsBSpline *spline,
+                 const tsReal *profile,
+                 size_t num_profile,
+                 int closed,
+                 size_t num_steps,
+                 tsReal max_angle,
+                 const tsSink *vertices,
+                 const tsSink *normals,
+                 unsigned int *indices,
+                 size_t *num_rings,
+                 tsStatus *status)
+{
+	const size_t dim = ts_bspline_dimension(spline);
+	const size_t len_ws = ts_int_bspline_len_derivs_ws(spline, 1);
+	const size_t num_quads = closed ? num_profile : num_profile - 1;
+	tsReal *ws = NULL;   /**< Workspace of the evaluation. */
+	tsReal *derivs;      /**< Point (derivs) and tangent (derivs + dim). */
+	tsReal *pnormals;    /**< Normals of `profile' (2D). */
+	tsFrame frames[2];   /**< Current and next frame. */
+	tsFrame *curr = frames, *next = frames + 1, *swap;
+	tsReal last[3];      /**< Tangent of the last ring. */
+	tsReal min, max, u, e[2], len, cos_max;
+	size_t i, j, k, a, b, rings = 0;
+	tsError err;
+
+	*num_rings = 0;
+	if (num_profile < 2) {
+		TS_RETURN_1(status, TS_NUM_POINTS,
+		            "num(profile) (%lu) < 2",
+		            (unsigned long) num_profile)
+	}
+	if (num_steps < 2) num_steps = 2;
+	if (indices && num_steps > UINT_MAX / num_profile) {
+		TS_RETURN_2(status, TS_NUM_POINTS,
+		            "num(vertices) (%lu * %lu) exceeds index range",
+		            (unsigned long) num_steps,
+		            (unsigned long) num_profile)
+	}
+	max_angle = (tsReal) fabs(max_angle);
+	cos_max = (tsReal) cos(max_angle > TS_PI ? TS_PI : max_angle);
+
+	ws = (tsReal *) malloc((len_ws + 2 * dim + 2 * num_profile) *
+	                       sizeof(tsReal));
+	if (!ws) TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	derivs = ws + len_ws;
+	pnormals = derivs + 2 * dim;
+
+	TS_TRY(try, err, status)
+		/* Profile normals are the averaged outward normals of the
+		 * adjacent edges (counter-clockwise winding). */
+		for (i = 0; i < num_profile; i++) {
+			pnormals[i*2] = pnormals[i*2 + 1] = (tsReal) 0.0;
+			for (k = 0; k < 2; k++) {
+				/* Edges (i-1, i) and (i, i+1). */
+				if (k == 0) {
+					if (i == 0 && !closed) continue;
+					a = i == 0 ? num_profile - 1 : i - 1;
+					b = i;
+				} else {
+					if (i == num_profile - 1 && !closed)
+						continue;
+					a = i;
+					b = (i + 1) % num_profile;
+				}
+				e[0] = profile[b*2] - profile[a*2];
+				e[1] = profile[b*2 + 1] - profile[a*2 + 1];
+				len = ts_vec_mag(e, 2);
+				if (len < TS_LENGTH_ZERO) continue;
+				pnormals[i*2] += e[1] / len;
+				pnormals[i*2 + 1] -= e[0] / len;
 			}
-		} else {
-			/* Never trust user input! */
-			ts_vec_norm(frames[0].normal, 3, frames[0].normal);
+			ts_vec_norm(pnormals + i*2, 2, pnormals + i*2);
 		}
-		/* Set binormal. */
-		ts_vec3_cross(frames[0].tangent,
-		              frames[0].normal,
-		              frames[0].binormal);
 
-		for (i = 0; i < num - 1; i++) {
-			/* Eval current and next point. */
-			TS_CALL(try, err, ts_int_bspline_eval_woa(
-			        spline, knots[i], &curr, status))
-			TS_CALL(try, err, ts_int_bspline_eval_woa(
-			        spline, knots[i+1], &next, status))
-			ts_vec3_set(xc, /* xc is now the current point */
-			            ts_int_deboornet_access_result(&curr),
-			            ts_bspline_dimension(spline));
-			ts_vec3_set(xn, /* xn is now the next point */
-			            ts_int_deboornet_access_result(&next),
-			            ts_bspline_dimension(spline));
-
-			/* Set position of U_{i+1}. */
-			ts_vec3_set(frames[i+1].position, xn, 3);
-
-			/* Compute reflection vector of R_{1}. */
-			ts_vec_sub(xn, xc, 3, v1);
-			c1 = ts_vec_dot(v1, v1, 3);
-
-			/* Compute r_{i}^{L} = R_{1} * r_{i}. */
-			rL[0] = (tsReal) 2.0 / c1;
-			rL[1] = ts_vec_dot(v1, frames[i].normal, 3);
-			rL[2] = rL[0] * rL[1];
-			ts_vec_mul(v1, 3, rL[2], rL);
-			ts_vec_sub(frames[i].normal, rL, 3, rL);
-
-			/* Compute t_{i}^{L} = R_{1} * t_{i}. */
-			tL[0] = (tsReal) 2.0 / c1;
-			tL[1] = ts_vec_dot(v1, frames[i].tangent, 3);
-			tL[2] = tL[0] * tL[1];
-			ts_vec_mul(v1, 3, tL[2], tL);
-			ts_vec_sub(frames[i].tangent, tL, 3, tL);
-
-			/* Compute reflection vector of R_{2}. */
-			TS_CALL(try, err, ts_int_bspline_eval_woa(
-			        &deriv, knots[i+1], &next, status))
-			ts_vec3_set(xn, /* xn is now the next tangent */
-			            ts_int_deboornet_access_result(&next),
-			            ts_bspline_dimension(&deriv));
-			ts_vec_norm(xn, 3, xn);
-			ts_vec_sub(xn, tL, 3, v2);
-			c2 = ts_vec_dot(v2, v2, 3);
-
-			/* Compute r_{i+1} = R_{2} * r_{i}^{L}. */
-			ts_vec3_set(xc, /* xc is now the next normal */
-			            frames[i+1].normal, 3);
-			xc[0] = (tsReal) 2.0 / c2;
-			xc[1] = ts_vec_dot(v2, rL, 3);
-			xc[2] = xc[0] * xc[1];
-			ts_vec_mul(v2, 3, xc[2], xc);
-			ts_vec_sub(rL, xc, 3, xc);
-			ts_vec_norm(xc, 3, xc);
-
-			/* Compute vector s_{i+1} of U_{i+1}. */
-			ts_vec3_cross(xn, xc, frames[i+1].binormal);
-
-			/* Set vectors t_{i+1} and r_{i+1} of U_{i+1}. */
-			ts_vec3_set(frames[i+1].tangent, xn, 3);
-			ts_vec3_set(frames[i+1].normal, xc, 3);
+		ts_bspline_domain(spline, &min, &max);
+		for (i = 0; i < num_steps; i++) {
+			u = i == num_steps - 1 ? max
+				: min + (max - min) * i / (num_steps - 1);
+			TS_CALL(try, err, ts_int_bspline_eval_derivs_woa(
+			        spline, u, 1, ws, derivs, status))
+			if (i == 0) {
+				ts_int_rmf_first(derivs, dim, 0, next);
+			} else {
+				ts_int_rmf_next(curr, derivs, dim, next);
+			}
+			swap = curr;
+			curr = next;
+			next = swap;
+
+			/* Emit a ring at both ends and whenever the tangent
+			 * turned by more than `max_angle' since the last
+			 * ring. */
+			if (i > 0 && i < num_steps - 1 &&
+			    ts_vec_dot(last, curr->tangent, 3) > cos_max)
+				continue;
+			ts_vec3_set(last, curr->tangent, 3);
+			ts_int_sweep_ring(curr, profile, pnormals, num_profile,
+			                  rings * num_profile, vertices, normals);
+			if (indices && rings > 0) {
+				a = (rings - 1) * num_profile;
+				b = rings * num_profile;
+				for (j = 0; j < num_quads; j++) {
+					k = (j + 1) % num_profile;
+					*indices++ = (unsigned int) (a + j);
+					*indices++ = (unsigned int) (a + k);
+					*indices++ = (unsigned int) (b + j);
+					*indices++ = (unsigned int) (a + k);
+					*indices++ = (unsigned int) (b + k);
+					*indices++ = (unsigned int) (b + j);
+				}
+			}
+			rings++;
 		}
+		*num_rings = rings;
 	TS_FINALLY
-		ts_bspline_free(&deriv);
-		ts_deboornet_free(&curr);
-		ts_deboornet_free(&next);
+		free(ws);
 	TS_END_TRY_RETURN(err)
 }
 
-
 tsError
 ts_bspline_chord_lengths(const tsBSpline *spline,
                          const tsReal *knots,
@@ -1739,6 +3584,130 @@ ts_bspline_chord_lengths(const tsBSpline *spline,
 }
 
 
+tsError
+ts_int_bspline_trim(tsBSpline *spline,
+                    size_t lead,  /* control points/knots to drop in front */
+                    size_t trail, /* control points/knots to drop at back */
+                    tsStatus *status)
+{
+	const size_t dim = ts_bspline_dimension(spline);
+	const size_t nc = ts_bspline_num_control_points(spline) - lead - trail;
+	const size_t nk = ts_bspline_num_knots(spline) - lead - trail;
+	tsReal *ctrlp, *knots;
+	tsError err;
+
+	if (lead == 0 && trail == 0)
+		TS_RETURN_SUCCESS(status)
+	TS_CALL_ROE(err, ts_int_bspline_own_ctrlp(spline, &ctrlp, status))
+	TS_CALL_ROE(err, ts_int_bspline_own_knots(spline, &knots, status))
+	/* Move control points. */
+	memmove(ctrlp, ctrlp + lead * dim, nc * dim * sizeof(tsReal));
+	/* Move knots. */
+	memmove(knots, knots + lead, nk * sizeof(tsReal));
+	spline->pImpl->n_ctrlp = nc;
+	spline->pImpl->n_knots = nk;
+	/* Shrink the memory of `spline'. */
+	ts_int_block_shrink(&spline->pImpl->ctrlp, nc * dim);
+	ts_int_block_shrink(&spline->pImpl->knots, nk);
+	TS_RETURN_SUCCESS(status)
+}
+
+tsError
+ts_int_bspline_refine_knots(const tsBSpline *spline,
+                            const tsReal *X, /* sorted and snapped */
+                            size_t num,
+                            tsBSpline *result,
+                            tsStatus *status)
+{
+	const size_t deg = ts_bspline_degree(spline);
+	const size_t dim = ts_bspline_dimension(spline);
+	const size_t num_ctrlp = ts_bspline_num_control_points(spline);
+	const size_t num_knots = ts_bspline_num_knots(spline);
+	const size_t sof_ctrlp = dim * sizeof(tsReal);
+	const tsReal *P = ts_int_bspline_access_ctrlp(spline);
+	const tsReal *U = ts_int_bspline_access_knots(spline);
+
+	tsBSpline tmp; /**< Temporarily stores the result. */
+	tsReal *Q;     /**< Control points of `tmp'. */
+	tsReal *Ubar;  /**< Knots of `tmp'. */
+	tsReal first, last, alpha;
+	size_t a, b, i, j, k, l, d, ind;
+	tsError err;
+
+	INIT_OUT_BSPLINE(spline, result)
+	if (num == 0)
+		return ts_bspline_copy(spline, result, status);
+	first = X[0];
+	last = X[num - 1];
+	TS_CALL_ROE(err, ts_int_bspline_find_span(
+	            spline, &first, &a, status))
+	TS_CALL_ROE(err, ts_int_bspline_find_span(
+	            spline, &last, &b, status))
+	b++;
+	TS_CALL_ROE(err, ts_int_bspline_new(
+	            num_ctrlp + num, dim, deg, TS_OPENED, 0,
+	            &tmp, status))
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_int_bspline_own_knots(
+		        &tmp, &Ubar, status))
+	TS_CATCH(err)
+		ts_bspline_free(&tmp);
+	TS_END_TRY_ROE(err)
+	Q = ts_int_bspline_unshared_ctrlp(&tmp);
+
+	/* Based on 'The NURBS Book' (Les Piegl and Wayne Tiller), A5.4. */
+
+	/* Copy the control points and knots that are not affected. */
+	memcpy(Q, P, (a - deg + 1) * sof_ctrlp);
+	memcpy(Q + (b - 1 + num) * dim,
+	       P + (b - 1) * dim,
+	       (num_ctrlp - b + 1) * sof_ctrlp);
+	memcpy(Ubar, U, (a + 1) * sizeof(tsReal));
+	memcpy(Ubar + b + deg + num,
+	       U + b + deg,
+	       (num_knots - b - deg) * sizeof(tsReal));
+
+	/* Insert the knots from back to front. */
+	i = b + deg - 1;
+	k = b + deg + num - 1;
+	for (j = num; j-- > 0;) {
+		while (X[j] <= U[i] && i > a) {
+			memcpy(Q + (k - deg - 1) * dim,
+			       P + (i - deg - 1) * dim,
+			       sof_ctrlp);
+			Ubar[k] = U[i];
+			k--;
+			i--;
+		}
+		memcpy(Q + (k - deg - 1) * dim,
+		       Q + (k - deg) * dim,
+		       sof_ctrlp);
+		for (l = 1; l <= deg; l++) {
+			ind = k - deg + l;
+			if (ts_knots_equal(Ubar[k + l], X[j])) {
+				memcpy(Q + (ind - 1) * dim,
+				       Q + ind * dim,
+				       sof_ctrlp);
+			} else {
+				alpha = (Ubar[k + l] - X[j]) /
+				        (Ubar[k + l] - U[i - deg + l]);
+				for (d = 0; d < dim; d++) {
+					Q[(ind - 1) * dim + d] =
+						alpha * Q[(ind - 1) * dim + d] +
+						(1.f - alpha) * Q[ind * dim + d];
+				}
+			}
+		}
+		Ubar[k] = X[j];
+		k--;
+	}
+
+	if (spline == result)
+		ts_bspline_free(result);
+	ts_bspline_move(&tmp, result);
+	TS_RETURN_SUCCESS(status)
+}
+
 tsError
 ts_bspline_sub_spline(const tsBSpline *spline,
                       tsReal knot0,
@@ -1750,19 +3719,19 @@ ts_bspline_sub_spline(const tsBSpline *spline,
 	tsReal *tmp = NULL; /* a buffer to swap control points */
 	tsReal min, max; /* domain of `spline` */
 	size_t dim, deg, order; /* properties of `spline` (and `sub`) */
-	tsBSpline worker; /* stores the result of the `split' operations */
-	tsReal *ctrlp, *knots; /* control points and knots of `worker` */
-	size_t k0, k1; /* indices returned by the `split' operations */
-	size_t c0, c1; /* indices of the control points to be moved */
-	size_t nc, nk; /* number of control points and knots of `sub` */
+	tsBSpline worker; /* stores the result of the refinement */
+	tsReal *ctrlp; /* control points of `worker` */
+	tsReal X[2]; /* `knot0` and `knot1` (see `n0` and `n1`) */
+	tsReal *insert = NULL; /* the knots to be inserted */
+	size_t n0, n1; /* number of insertions of `knot0` and `knot1` */
+	size_t k0, k1; /* last indices of `knot0` and `knot1` in `worker` */
+	size_t nc; /* number of control points of `sub` */
+	size_t idx, mult; /* index and multiplicity of a knot */
 	size_t i; /* for various needs */
 	tsError err; /* for local try-catch block */
 
 	/* Make sure that `worker` points to `NULL'. This allows us to call
-	 * `ts_bspline_free` in `TS_CATCH` without further checks. Also, `NULL'
-	 * serves as an indicator of whether `ts_bspline_split` has been called
-	 * on `spline` at least once (if not, `worker` needs to be initialized
-	 * manually). */
+	 * `ts_bspline_free` in `TS_CATCH` without further checks. */
 	ts_int_bspline_init(&worker);
 	INIT_OUT_BSPLINE(spline, sub)
 
@@ -1791,64 +3760,51 @@ ts_bspline_sub_spline(const tsBSpline *spline,
 	}
 
 	TS_TRY(try, err, status)
-		if (!ts_knots_equal(knot0 , min)) {
-			TS_CALL(try , err, ts_bspline_split(
-			        spline, knot0, &worker, &k0, status))
-		} else { k0 = deg; }
+		/* Determine how often `knot0` and `knot1` must be inserted
+		 * such that their multiplicity is equal to `order`. */
+		n0 = n1 = 0;
+		k0 = deg;
+		if (!ts_knots_equal(knot0, min)) {
+			X[0] = knot0;
+			TS_CALL(try, err, ts_int_bspline_find_knot(
+			        spline, &X[0], &idx, &mult, status))
+			n0 = order - mult;
+			k0 = idx + n0;
+		}
+		k1 = ts_bspline_num_knots(spline) - 1;
 		if (!ts_knots_equal(knot1, max)) {
-			TS_CALL(try , err, ts_bspline_split(
-			        /* If `NULL', the split operation
-			           above was not called. */
-			        !worker.pImpl ? spline : &worker,
-			        knot1, &worker, &k1, status))
-		} else {
-			k1 = ts_bspline_num_knots(
-			        /* If `NULL', the split operation
-			           above was not called. */
-			        !worker.pImpl ? spline : &worker) - 1;
+			X[1] = knot1;
+			TS_CALL(try, err, ts_int_bspline_find_knot(
+			        spline, &X[1], &idx, &mult, status))
+			n1 = order - mult;
+			k1 = idx + n1;
 		}
+		k1 += n0;
 
 		/* Set up `worker`. */
-		if (!worker.pImpl) { /* => no split applied */
-			TS_CALL(try, err, ts_bspline_copy(
-			        spline, &worker, status))
-			/* Needed in `reverse mode'. */
-			ctrlp = ts_int_bspline_access_ctrlp(&worker);
-			knots = ts_int_bspline_access_knots(&worker);
-			nc = ts_bspline_num_control_points(&worker);
-		} else {
-			c0 = (k0-deg) * dim;
-			c1 = (k1-order) * dim;
-			nc = ((c1-c0) / dim) + 1;
-			nk = (k1-k0) + order;
-
-			/* Also needed in `reverse mode'. */
-			ctrlp = ts_int_bspline_access_ctrlp(&worker);
-			knots = ts_int_bspline_access_knots(&worker);
-
-			/* Move control points. */
-			memmove(ctrlp,
-			        ctrlp + c0,
-			        nc * dim * sizeof(tsReal));
-			/* Move knots. */
-			memmove(ctrlp + nc * dim,
-			        knots + (k0-deg),
-			        nk * sizeof(tsReal));
-
-			/* Remove superfluous control points and knots from
-			 * the memory of `worker`. */
-			worker.pImpl->n_knots = nk;
-			worker.pImpl->n_ctrlp = nc;
-			i = ts_int_bspline_sof_state(&worker);
-			worker.pImpl = realloc(worker.pImpl, i);
-			if (worker.pImpl == NULL) { /* unlikely to fail */
+		if (n0 + n1 > 0) {
+			insert = (tsReal *) malloc(
+				(n0 + n1) * sizeof(tsReal));
+			if (!insert) {
 				TS_THROW_0(try, err, status, TS_MALLOC,
 				           "out of memory")
 			}
+			for (i = 0; i < n0; i++) insert[i] = X[0];
+			for (i = 0; i < n1; i++) insert[n0 + i] = X[1];
 		}
+		TS_CALL(try, err, ts_int_bspline_refine_knots(
+		        spline, insert, n0 + n1, &worker, status))
+
+		/* Remove superfluous control points and knots. */
+		TS_CALL(try, err, ts_int_bspline_trim(
+		        &worker, k0 - deg,
+		        ts_bspline_num_knots(&worker) - 1 - k1, status))
+		nc = ts_bspline_num_control_points(&worker);
 
 		/* Reverse control points (if necessary). */
 		if (reverse) {
+			TS_CALL(try, err, ts_int_bspline_own_ctrlp(
+			        &worker, &ctrlp, status))
 			for (i = 0; i < nc / 2; i++) {
 				memcpy(tmp,
 				       ctrlp  +     i      * dim,
@@ -1869,6 +3825,7 @@ ts_bspline_sub_spline(const tsBSpline *spline,
 		ts_bspline_free(&worker);
 	TS_FINALLY
 		if (tmp) free(tmp);
+		if (insert) free(insert);
 	TS_END_TRY_RETURN(err)
 }
 
@@ -1959,11 +3916,16 @@ ts_int_bspline_resize(const tsBSpline *spline,
 	if (n == 0) return ts_bspline_copy(spline, resized, status);
 
 	INIT_OUT_BSPLINE(spline, resized)
-	TS_CALL_ROE(err, ts_bspline_new(
-	            nnum_ctrlp, dim, deg, TS_OPENED,
+	TS_CALL_ROE(err, ts_int_bspline_new(
+	            nnum_ctrlp, dim, deg, TS_OPENED, 0,
 	            &tmp, status))
-	to_ctrlp = ts_int_bspline_access_ctrlp(&tmp);
-	to_knots = ts_int_bspline_access_knots(&tmp);
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_int_bspline_own_knots(
+		        &tmp, &to_knots, status))
+	TS_CATCH(err)
+		ts_bspline_free(&tmp);
+	TS_END_TRY_ROE(err)
+	to_ctrlp = ts_int_bspline_unshared_ctrlp(&tmp);
 
 	/* Copy control points and knots. */
 	if (!back && n < 0) {
@@ -2009,14 +3971,18 @@ ts_bspline_derive(const tsBSpline *spline,
 	tsReal span; /**< Distance between kid1 and ki1. */
 
 	tsBSpline swap; /**< Used to swap worker and derivative. */
+	tsReal *swap_knots; /**< Pointer to the knots of swap. */
 	tsError err;
 
 	INIT_OUT_BSPLINE(spline, deriv)
 	TS_CALL_ROE(err, ts_bspline_copy(spline, &worker, status))
-	ctrlp = ts_int_bspline_access_ctrlp(&worker);
-	knots = ts_int_bspline_access_knots(&worker);
+	swap = ts_bspline_init();
 
 	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_int_bspline_own_ctrlp(
+		        &worker, &ctrlp, status))
+		TS_CALL(try, err, ts_int_bspline_own_knots(
+		        &worker, &knots, status))
 		for (m = 1; m <= n; m++) { /* from 1st to n'th derivative */
 			if (deg == 0) {
 				ts_arr_fill(ctrlp, dim, 0.f);
@@ -2070,20 +4036,21 @@ ts_bspline_derive(const tsBSpline *spline,
 			num_knots -= 2;
 			knots     += 1;
 		}
-		TS_CALL(try, err, ts_bspline_new(
-		        num_ctrlp, dim, deg, TS_OPENED,
+		TS_CALL(try, err, ts_int_bspline_new(
+		        num_ctrlp, dim, deg, TS_OPENED, 0,
 		        &swap, status))
-		memcpy(ts_int_bspline_access_ctrlp(&swap),
+		memcpy(ts_int_bspline_unshared_ctrlp(&swap),
 		       ctrlp,
 		       num_ctrlp * sof_ctrlp);
-		memcpy(ts_int_bspline_access_knots(&swap),
-		       knots,
-		       num_knots * sof_real);
+		TS_CALL(try, err, ts_int_bspline_own_knots(
+		        &swap, &swap_knots, status))
+		memcpy(swap_knots, knots, num_knots * sof_real);
 		if (spline == deriv)
 			ts_bspline_free(deriv);
 		ts_bspline_move(&swap, deriv);
 	TS_FINALLY
 		ts_bspline_free(&worker);
+		ts_bspline_free(&swap);
 	TS_END_TRY_RETURN(err)
 }
 
@@ -2109,8 +4076,8 @@ ts_int_bspline_insert_knot(const tsBSpline *spline,
 	int stride;   /**< Stride of the next pointer to copy. */
 	size_t i;     /**< Used in for loops. */
 
-	tsReal *ctrlp_spline, *ctrlp_result;
-	tsReal *knots_spline, *knots_result;
+	const tsReal *ctrlp_spline, *knots_spline;
+	tsReal *ctrlp_result, *knots_result;
 	size_t num_ctrlp_result;
 	size_t num_knots_result;
 
@@ -2128,10 +4095,18 @@ ts_int_bspline_insert_knot(const tsBSpline *spline,
 
 	TS_CALL_ROE(err, ts_int_bspline_resize(
 	            spline, (int)n, 1, result, status))
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_int_bspline_own_ctrlp(
+		        result, &ctrlp_result, status))
+		TS_CALL(try, err, ts_int_bspline_own_knots(
+		        result, &knots_result, status))
+	TS_CATCH(err)
+		ts_bspline_free(result);
+	TS_END_TRY_ROE(err)
+	/* If `spline' and `result' are the same instance, `spline' has been
+	 * resized already. */
 	ctrlp_spline = ts_int_bspline_access_ctrlp(spline);
 	knots_spline = ts_int_bspline_access_knots(spline);
-	ctrlp_result = ts_int_bspline_access_ctrlp(result);
-	knots_result = ts_int_bspline_access_knots(result);
 	num_ctrlp_result = ts_bspline_num_control_points(result);
 	num_knots_result = ts_bspline_num_knots(result);
 
@@ -2235,6 +4210,55 @@ ts_bspline_insert_knot(const tsBSpline *spline,
 	TS_END_TRY_RETURN(err)
 }
 
+tsError
+ts_bspline_refine_knots(const tsBSpline *spline,
+                        const tsReal *knots,
+                        size_t num,
+                        tsBSpline *result,
+                        tsStatus *status)
+{
+	const size_t order = ts_bspline_order(spline);
+	tsReal *X = NULL; /**< Validated and snapped copy of `knots'. */
+	size_t i, j, idx, mult;
+	tsError err;
+
+	INIT_OUT_BSPLINE(spline, result)
+	if (num == 0)
+		return ts_bspline_copy(spline, result, status);
+	X = (tsReal *) malloc(num * sizeof(tsReal));
+	if (!X) TS_RETURN_0(status, TS_MALLOC, "out of memory")
+
+	TS_TRY(try, err, status)
+		for (i = 0; i < num; i = j) {
+			if (i > 0 && knots[i] < X[i - 1]) {
+				TS_THROW_2(try, err, status, TS_KNOTS_DECR,
+				           "decreasing knots: %f < %f",
+				           knots[i], X[i - 1])
+			}
+			X[i] = knots[i];
+			TS_CALL(try, err, ts_int_bspline_find_knot(
+			        spline, &X[i], &idx, &mult, status))
+			/* Snap the duplicates of `X[i]'. */
+			for (j = i + 1; j < num &&
+			     ts_knots_equal(knots[j], X[i]); j++) {
+				X[j] = X[i];
+			}
+			if (mult + (j - i) > order) {
+				TS_THROW_4(try, err, status, TS_MULTIPLICITY,
+				           "multiplicity(%f) (%lu) + %lu > "
+				           "order (%lu)", X[i],
+				           (unsigned long) mult,
+				           (unsigned long) (j - i),
+				           (unsigned long) order)
+			}
+		}
+		TS_CALL(try, err, ts_int_bspline_refine_knots(
+		        spline, X, num, result, status))
+	TS_FINALLY
+		free(X);
+	TS_END_TRY_RETURN(err)
+}
+
 tsError
 ts_bspline_split(const tsBSpline *spline,
                  tsReal knot,
@@ -2242,30 +4266,30 @@ ts_bspline_split(const tsBSpline *spline,
                  size_t* k,
                  tsStatus *status)
 {
-	tsDeBoorNet net;
+	const size_t order = ts_bspline_order(spline);
+	tsReal *X = NULL; /**< `knot' repeated `order - mult' times. */
+	size_t idx, mult, i;
 	tsError err;
+
 	INIT_OUT_BSPLINE(spline, split)
-	ts_int_deboornet_init(&net);
+	*k = 0;
+	TS_CALL_ROE(err, ts_int_bspline_find_knot(
+	            spline, &knot, &idx, &mult, status))
+	if (mult == order) {
+		TS_CALL_ROE(err, ts_bspline_copy(spline, split, status))
+		*k = idx;
+		TS_RETURN_SUCCESS(status)
+	}
+	X = (tsReal *) malloc((order - mult) * sizeof(tsReal));
+	if (!X) TS_RETURN_0(status, TS_MALLOC, "out of memory")
+	for (i = 0; i < order - mult; i++)
+		X[i] = knot;
 	TS_TRY(try, err, status)
-		TS_CALL(try, err, ts_bspline_eval(
-		        spline, knot, &net, status))
-		if (ts_deboornet_multiplicity(&net)
-		    == ts_bspline_order(spline)) {
-			TS_CALL(try, err, ts_bspline_copy(
-			        spline, split, status))
-			*k = ts_deboornet_index(&net);
-		} else {
-			TS_CALL(try, err, ts_int_bspline_insert_knot(
-			        spline, &net,
-			        ts_deboornet_num_insertions(&net) + 1,
-			        split, status))
-			*k = ts_deboornet_index(&net) +
-			     ts_deboornet_num_insertions(&net) + 1;
-		}
-	TS_CATCH(err)
-		*k = 0;
+		TS_CALL(try, err, ts_int_bspline_refine_knots(
+		        spline, X, order - mult, split, status))
+		*k = idx + (order - mult);
 	TS_FINALLY
-		ts_deboornet_free(&net);
+		free(X);
 	TS_END_TRY_RETURN(err)
 }
 
@@ -2287,7 +4311,12 @@ ts_bspline_tension(const tsBSpline *spline,
 	tsError err;
 
 	TS_CALL_ROE(err, ts_bspline_copy(spline, out, status))
-	ctrlp = ts_int_bspline_access_ctrlp(out);
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_int_bspline_own_ctrlp(
+		        out, &ctrlp, status))
+	TS_CATCH(err)
+		if (spline != out) ts_bspline_free(out);
+	TS_END_TRY_ROE(err)
 	if (beta < (tsReal) 0.0) beta = (tsReal) 0.0;
 	if (beta > (tsReal) 1.0) beta = (tsReal) 1.0;
 	s = 1.f - beta;
@@ -2309,67 +4338,67 @@ ts_bspline_to_beziers(const tsBSpline *spline,
 {
 	const size_t deg = ts_bspline_degree(spline);
 	const size_t order = ts_bspline_order(spline);
+	const size_t num_knots = ts_bspline_num_knots(spline);
+	const tsReal *knots = ts_int_bspline_access_knots(spline);
+	const size_t last = num_knots - order; /**< Index of u_max. */
 
-	int resize;    /**< Number of control points to add/remove. */
-	size_t k;      /**< Index of the split knot value. */
-	tsReal u_min;  /**< Minimum of the knot values. */
-	tsReal u_max;  /**< Maximum of the knot values. */
-
-	tsBSpline tmp;    /**< Temporarily stores the result. */
-	tsReal *knots;    /**< Pointer to the knots of tmp. */
-	size_t num_knots; /**< Number of knots in tmp. */
+	size_t i, j, m;   /**< Used in for loops. */
+	size_t num;       /**< Number of knots to insert. */
+	size_t lead;      /**< Number of knots in front of u_min. */
+	size_t trail;     /**< Number of knots behind u_max. */
+	tsReal *X = NULL; /**< Knots to insert. */
 
+	tsBSpline tmp; /**< Temporarily stores the result. */
 	tsError err;
 
 	INIT_OUT_BSPLINE(spline, beziers)
-	TS_CALL_ROE(err, ts_bspline_copy(spline, &tmp, status))
-	knots = ts_int_bspline_access_knots(&tmp);
-	num_knots = ts_bspline_num_knots(&tmp);
+	ts_int_bspline_init(&tmp);
+
+	/* Each knot value of the domain [u_min, u_max] must have multiplicity
+	 * `order'. Count the knots to insert and the knots that are outside
+	 * of the domain. The latter are removed after refinement (opened knot
+	 * vectors). */
+	num = lead = trail = 0;
+	for (i = 0; i < num_knots; i = j) {
+		for (j = i + 1; j < num_knots &&
+		     ts_knots_equal(knots[i], knots[j]); j++);
+		if (j <= deg) {
+			lead = j;
+		} else if (i > last) {
+			trail += j - i;
+		} else if (j - i < order) {
+			num += order - (j - i);
+		}
+	}
 
 	TS_TRY(try, err, status)
-		/* DO NOT FORGET TO UPDATE knots AND num_knots AFTER EACH
-		 * TRANSFORMATION OF tmp! */
-
-		/* Fix first control point if necessary. */
-		u_min = knots[deg];
-		if (!ts_knots_equal(knots[0], u_min)) {
-			TS_CALL(try, err, ts_bspline_split(
-			        &tmp, u_min, &tmp, &k, status))
-			resize = (int)(-1*deg + (deg*2 - k));
-			TS_CALL(try, err, ts_int_bspline_resize(
-			        &tmp, resize, 0, &tmp, status))
-			knots = ts_int_bspline_access_knots(&tmp);
-			num_knots = ts_bspline_num_knots(&tmp);
-		}
-
-		/* Fix last control point if necessary. */
-		u_max = knots[num_knots - order];
-		if (!ts_knots_equal(knots[num_knots - 1], u_max)) {
-			TS_CALL(try, err, ts_bspline_split(
-			        &tmp, u_max, &tmp, &k, status))
-			num_knots = ts_bspline_num_knots(&tmp);
-			resize = (int)(-1*deg + (k - (num_knots - order)));
-			TS_CALL(try, err, ts_int_bspline_resize(
-			        &tmp, resize, 1, &tmp, status))
-			knots = ts_int_bspline_access_knots(&tmp);
-			num_knots = ts_bspline_num_knots(&tmp);
-		}
-
-		/* Split internal knots. */
-		k = order;
-		while (k < num_knots - order) {
-			TS_CALL(try, err, ts_bspline_split(
-			        &tmp, knots[k], &tmp, &k, status))
-			knots = ts_int_bspline_access_knots(&tmp);
-			num_knots = ts_bspline_num_knots(&tmp);
-			k++;
+		if (num > 0) {
+			X = (tsReal *) malloc(num * sizeof(tsReal));
+			if (!X) {
+				TS_THROW_0(try, err, status, TS_MALLOC,
+				           "out of memory")
+			}
+			num = 0;
+			for (i = 0; i < num_knots; i = j) {
+				for (j = i + 1; j < num_knots &&
+				     ts_knots_equal(knots[i], knots[j]); j++);
+				if (j <= deg || i > last)
+					continue;
+				for (m = j - i; m < order; m++)
+					X[num++] = knots[i];
+			}
 		}
+		TS_CALL(try, err, ts_int_bspline_refine_knots(
+		        spline, X, num, &tmp, status))
+		TS_CALL(try, err, ts_int_bspline_trim(
+		        &tmp, lead, trail, status))
 
 		if (spline == beziers)
 			ts_bspline_free(beziers);
 		ts_bspline_move(&tmp, beziers);
 	TS_FINALLY
 		ts_bspline_free(&tmp);
+		if (X) free(X);
 	TS_END_TRY_RETURN(err)
 }
 
@@ -2412,8 +4441,10 @@ ts_bspline_elevate_degree(const tsBSpline *spline,
 		        status));
 		dim = ts_bspline_dimension(&worker);
 		order = ts_bspline_order(&worker);
-		ctrlp = ts_int_bspline_access_ctrlp(&worker);
-		knots = ts_int_bspline_access_knots(&worker);
+		TS_CALL(try, err, ts_int_bspline_own_ctrlp(
+		        &worker, &ctrlp, status))
+		TS_CALL(try, err, ts_int_bspline_own_knots(
+		        &worker, &knots, status))
 
 		/* Move all but the first bezier curve to their new location in
 		 * the control point array so that the additional control
@@ -2608,14 +4639,10 @@ ts_bspline_elevate_degree(const tsBSpline *spline,
 		worker.pImpl->deg = order - 1;
 		worker.pImpl->n_knots -= d;
 		worker.pImpl->n_ctrlp = ts_bspline_num_knots(&worker) - order;
-		memmove(ts_int_bspline_access_knots(&worker),
-		        knots, ts_bspline_sof_knots(&worker));
-		worker.pImpl = realloc(worker.pImpl,
-		                       ts_int_bspline_sof_state(&worker));
-		if (worker.pImpl == NULL) {
-			TS_THROW_0(try, err, status, TS_MALLOC,
-			           "out of memory")
-		}
+		ts_int_block_shrink(&worker.pImpl->ctrlp,
+		                    ts_bspline_len_control_points(&worker));
+		ts_int_block_shrink(&worker.pImpl->knots,
+		                    ts_bspline_num_knots(&worker));
 
 		/* Move `worker' to output parameter. */
 		if (spline == elevated)
@@ -2635,9 +4662,9 @@ ts_bspline_align(const tsBSpline *s1,
                  tsStatus *status)
 {
 	tsBSpline s1_worker, s2_worker, *smaller, *larger;
-	tsDeBoorNet net; /* the net of `smaller'. */
-	size_t i, missing, remaining;
-	tsReal min, max, shift, nextKnot;
+	tsReal *insert = NULL; /* the knots to be inserted into `smaller'. */
+	size_t deg, i, j, k, idx, mult, missing;
+	tsReal min, max, shift, nextKnot, knot;
 	tsError err;
 
 	INIT_OUT_BSPLINE(s1, s1_out)
@@ -2668,7 +4695,7 @@ ts_bspline_align(const tsBSpline *s1,
 			        s2, &s2_worker, status))
 		}
 
-		/* Set up `smaller', `larger', and `net'. */
+		/* Set up `smaller' and `larger'. */
 		if (ts_bspline_num_knots(&s1_worker) <
 		    ts_bspline_num_knots(&s2_worker)) {
 			smaller = &s1_worker;
@@ -2677,24 +4704,46 @@ ts_bspline_align(const tsBSpline *s1,
 			smaller = &s2_worker;
 			larger  = &s1_worker;
 		}
-		TS_CALL(try, err, ts_int_deboornet_new(
-		        smaller, &net, status))
+		deg = ts_bspline_degree(smaller);
 
-		/* Insert knots into `smaller' until it has the same number of
-		 * knots (and therefore the same number of control points) as
-		 * `larger'. */
+		/* Collect the knots to be inserted into `smaller' such that it
+		 * has the same number of knots (and therefore the same number
+		 * of control points) as `larger'. `insert' is kept sorted. */
 		ts_bspline_domain(smaller, &min, &max);
-		missing = remaining = ts_bspline_num_knots(larger) -
-			              ts_bspline_num_knots(smaller);
+		missing = ts_bspline_num_knots(larger) -
+		          ts_bspline_num_knots(smaller);
+		if (missing > 0) {
+			insert = (tsReal *) malloc(missing * sizeof(tsReal));
+			if (!insert) {
+				TS_THROW_0(try, err, status, TS_MALLOC,
+				           "out of memory")
+			}
+		}
 		shift = (tsReal) 0.0;
 		if (missing > 0)
 			shift = ( (tsReal) 1.0 / missing ) * (tsReal) 0.5;
-		for (i = 0; remaining > 0; i++, remaining--) {
+		for (i = 0; i < missing; i++) {
 			nextKnot = (max - min) * ((tsReal)i / missing) + min;
 			nextKnot += shift;
-			TS_CALL(try, err, ts_int_bspline_eval_woa(
-			        smaller, nextKnot, &net, status))
-			while (!ts_deboornet_num_insertions(&net)) {
+			for (;;) {
+				knot = nextKnot; /* snapped to existing knots */
+				TS_CALL(try, err, ts_int_bspline_find_knot(
+				        smaller, &knot, &idx, &mult, status))
+				/* Position of `knot' in `insert' and its
+				 * multiplicity in the refined spline. */
+				for (j = i; j > 0 && knot < insert[j - 1]; j--);
+				for (k = j; k > 0 && ts_knots_equal(
+				     knot, insert[k - 1]); k--) {
+					knot = insert[k - 1];
+					mult++;
+				}
+				for (k = j; k < i && ts_knots_equal(
+				     knot, insert[k]); k++) {
+					knot = insert[k];
+					mult++;
+				}
+				if (mult < deg)
+					break;
 				/* Linear exploration for next knot. */
 				nextKnot += 5 * TS_KNOT_EPSILON;
 				if (nextKnot > max) {
@@ -2702,12 +4751,13 @@ ts_bspline_align(const tsBSpline *s1,
 					           TS_NO_RESULT,
 					          "no more knots for insertion")
 				}
-				TS_CALL(try, err, ts_int_bspline_eval_woa(
-				        smaller, nextKnot, &net, status))
 			}
-			TS_CALL(try, err, ts_int_bspline_insert_knot(
-			        smaller, &net, 1, smaller, status))
+			memmove(insert + j + 1, insert + j,
+			        (i - j) * sizeof(tsReal));
+			insert[j] = knot;
 		}
+		TS_CALL(try, err, ts_int_bspline_refine_knots(
+		        smaller, insert, missing, smaller, status))
 
 		if (s1 == s1_out)
 			ts_bspline_free(s1_out);
@@ -2722,10 +4772,105 @@ ts_bspline_align(const tsBSpline *s1,
 	TS_FINALLY
 		ts_bspline_free(&s1_worker);
 		ts_bspline_free(&s2_worker);
-		ts_deboornet_free(&net);
+		if (insert) free(insert);
 	TS_END_TRY_RETURN(err)
 }
 
+tsError
+ts_int_morph_blend(const tsReal *origin_c, /* control points of origin */
+                   size_t origin_dim,      /* dimension of origin */
+                   const tsReal *target_c, /* control points of target */
+                   size_t target_dim,      /* dimension of target */
+                   const tsReal *origin_k, /* knots of origin */
+                   const tsReal *target_k, /* knots of target */
+                   struct tsBlock *shared, /* knots of both (or NULL) */
+                   size_t deg,
+                   size_t num_ctrlp,
+                   tsReal t,
+                   tsBSpline *out,
+                   tsStatus *status)
+{
+	/* Properties of `out'. */
+	const size_t dim = origin_dim < target_dim ? origin_dim : target_dim;
+	size_t num_knots;
+	tsReal *ctrlp, *knots;
+	tsBSpline tmp; /* temporary buffer if `out' must be resized */
+	struct tsBlock *block;
+
+	tsReal t_hat;
+	size_t i, d;
+	tsError err;
+
+	/* Clamp `t' to domain [0, 1] and set up `t_hat'. */
+	if (t < (tsReal) 0.0) t = (tsReal) 0.0;
+	if (t > (tsReal) 1.0) t = (tsReal) 1.0;
+	t_hat = (tsReal) 1.0 - t;
+
+	/* Set up `out'. */
+	if (out->pImpl == NULL) {
+		TS_CALL_ROE(err, ts_int_bspline_new(num_ctrlp, dim, deg,
+		            TS_OPENED /* doesn't matter */, 0, out, status))
+	} else if (ts_bspline_degree(out) != deg ||
+	           ts_bspline_num_control_points(out) != num_ctrlp ||
+	           ts_bspline_dimension(out) != dim) {
+		TS_CALL_ROE(err, ts_int_bspline_new(num_ctrlp, dim, deg,
+		            TS_OPENED /* doesn't matter */, 0, &tmp, status))
+		ts_bspline_free(out);
+		ts_bspline_move(&tmp, out);
+	}
+	num_knots = ts_bspline_num_knots(out);
+	TS_CALL_ROE(err, ts_int_bspline_own_ctrlp(out, &ctrlp, status))
+
+	/* Interpolate control points. */
+	for (i = 0; i < num_ctrlp; i++) {
+		for (d = 0; d < dim; d++) {
+			ctrlp[i * dim + d] =
+				t * target_c[i * target_dim + d] +
+				t_hat * origin_c[i * origin_dim + d];
+		}
+	}
+
+	/* Interpolate knots. If origin and target share their knots, so does
+	 * `out'. */
+	if (shared) {
+		if (out->pImpl->knots != shared) {
+			TS_CALL_ROE(err, ts_int_block_share(
+			            shared, num_knots, &block, status))
+			ts_int_block_release(out->pImpl->knots);
+			out->pImpl->knots = block;
+		}
+	} else {
+		TS_CALL_ROE(err, ts_int_bspline_own_knots(
+		            out, &knots, status))
+		for (i = 0; i < num_knots; i++) {
+			knots[i] = t * target_k[i] +
+			           t_hat * origin_k[i];
+		}
+	}
+	TS_RETURN_SUCCESS(status)
+}
+
+tsError
+ts_int_morph_align(const tsBSpline *origin,
+                   const tsBSpline *target,
+                   tsReal epsilon,
+                   tsBSpline *origin_al, /* out: aligned origin */
+                   tsBSpline *target_al, /* out: aligned target */
+                   tsStatus *status)
+{
+	/* Degree must be elevated... */
+	if (ts_bspline_degree(origin) != ts_bspline_degree(target) ||
+	 /* .. or knots (and thus control points) must be inserted. */
+	 ts_bspline_num_knots(origin) != ts_bspline_num_knots(target)) {
+		return ts_bspline_align(origin, target, epsilon,
+		                        origin_al, target_al, status);
+	}
+	/* Flat copy. */
+	*origin_al = *origin;
+	*target_al = *target;
+	TS_RETURN_SUCCESS(status)
+}
+
 tsError
 ts_bspline_morph(const tsBSpline *origin,
                  const tsBSpline *target,
@@ -2735,79 +4880,123 @@ ts_bspline_morph(const tsBSpline *origin,
                  tsStatus *status)
 {
 	tsBSpline origin_al, target_al; /* aligned origin and target */
-	tsReal *origin_al_c, *origin_al_k; /* control points and knots */
-	tsReal *target_al_c, *target_al_k; /* control points and knots */
+	tsError err;
 
-	/* Properties of `out'. */
-	size_t deg, dim, num_ctrlp, num_knots;
-	tsReal *ctrlp, *knots;
-	tsBSpline tmp; /* temporary buffer if `out' must be resized */
+	origin_al = ts_bspline_init();
+	target_al = ts_bspline_init();
+	TS_TRY(try, err, status)
+		TS_CALL(try, err, ts_int_morph_align(
+		        origin, target, epsilon, &origin_al, &target_al,
+		        status))
+		TS_CALL(try, err, ts_int_morph_blend(
+		        ts_int_bspline_access_ctrlp(&origin_al),
+		        ts_bspline_dimension(&origin_al),
+		        ts_int_bspline_access_ctrlp(&target_al),
+		        ts_bspline_dimension(&target_al),
+		        ts_int_bspline_access_knots(&origin_al),
+		        ts_int_bspline_access_knots(&target_al),
+		        origin_al.pImpl->knots == target_al.pImpl->knots ?
+		                origin_al.pImpl->knots : NULL,
+		        ts_bspline_degree(&origin_al),
+		        ts_bspline_num_control_points(&origin_al),
+		        t, out, status))
+	TS_FINALLY
+		if (origin->pImpl != origin_al.pImpl)
+			ts_bspline_free(&origin_al);
+		if (target->pImpl != target_al.pImpl)
+			ts_bspline_free(&target_al);
+	TS_END_TRY_RETURN(err)
+}
+/*! @} */
 
-	tsReal t_hat;
-	size_t i, offset, d;
+
+
+/*! @name Morph Plan
+ *
+ * @{
+ */
+tsMorphPlan
+ts_morphplan_init(void)
+{
+	tsMorphPlan plan;
+	ts_int_morphplan_init(&plan);
+	return plan;
+}
+
+tsError
+ts_morphplan_new(const tsBSpline *origin,
+                 const tsBSpline *target,
+                 tsReal epsilon,
+                 tsMorphPlan *plan,
+                 tsStatus *status)
+{
+	const size_t sof_real = sizeof(tsReal);
+	tsBSpline origin_al, target_al; /* aligned origin and target */
+	const tsReal *from;
+	tsReal *ctrlp, *knots;
+	struct tsBlock *shared;
+	size_t deg, dim, origin_dim, target_dim, num_ctrlp, num_knots, i;
 	tsError err;
 
+	ts_int_morphplan_init(plan);
 	origin_al = ts_bspline_init();
 	target_al = ts_bspline_init();
 	TS_TRY(try, err, status)
-		/* Clamp `t' to domain [0, 1] and set up `t_hat'. */
-		if (t < (tsReal) 0.0) t = (tsReal) 0.0;
-		if (t > (tsReal) 1.0) t = (tsReal) 1.0;
-		t_hat = (tsReal) 1.0 - t;
-
-		/* Set up `origin_al' and `target_al'. */
-		/* Degree must be elevated... */
-		if (ts_bspline_degree(origin) != ts_bspline_degree(target) ||
-		 /* .. or knots (and thus control points) must be inserted. */
-		 ts_bspline_num_knots(origin) != ts_bspline_num_knots(target)) {
-			TS_CALL(try, err, ts_bspline_align(
-			        origin, target, epsilon, &origin_al, &target_al,
-			        status));
-		} else {
-			/* Flat copy. */
-			origin_al = *origin;
-			target_al = *target;
-		}
-		origin_al_c = ts_int_bspline_access_ctrlp(&origin_al);
-		origin_al_k = ts_int_bspline_access_knots(&origin_al);
-		target_al_c = ts_int_bspline_access_ctrlp(&target_al);
-		target_al_k = ts_int_bspline_access_knots(&target_al);
-
-		/* Set up `out'. */
+		TS_CALL(try, err, ts_int_morph_align(
+		        origin, target, epsilon, &origin_al, &target_al,
+		        status))
 		deg = ts_bspline_degree(&origin_al);
 		num_ctrlp = ts_bspline_num_control_points(&origin_al);
-		dim = ts_bspline_dimension(&origin_al);
-		if (ts_bspline_dimension(&target_al) < dim)
-			dim = ts_bspline_dimension(&target_al);
-		if (out->pImpl == NULL) {
-			TS_CALL(try, err, ts_bspline_new(num_ctrlp, dim, deg,
-			        TS_OPENED /* doesn't matter */, out, status))
-		} else if (ts_bspline_degree(out) != deg ||
-		           ts_bspline_num_control_points(out) != num_ctrlp ||
-		           ts_bspline_dimension(out) != dim) {
-			TS_CALL(try, err, ts_bspline_new(num_ctrlp, dim, deg,
-			        TS_OPENED /* doesn't matter */, &tmp, status))
-			ts_bspline_free(out);
-			ts_bspline_move(&tmp, out);
-		}
-		num_knots = ts_bspline_num_knots(out);
-		ctrlp = ts_int_bspline_access_ctrlp(out);
-		knots = ts_int_bspline_access_knots(out);
-
-		/* Interpolate control points. */
+		num_knots = ts_bspline_num_knots(&origin_al);
+		origin_dim = ts_bspline_dimension(&origin_al);
+		target_dim = ts_bspline_dimension(&target_al);
+		dim = origin_dim < target_dim ? origin_dim : target_dim;
+		shared = origin_al.pImpl->knots == target_al.pImpl->knots ?
+		         origin_al.pImpl->knots : NULL;
+
+		plan->pImpl = (struct tsMorphPlanImpl *) malloc(
+			sizeof(struct tsMorphPlanImpl) +
+			(2 * num_ctrlp * dim +
+			 (shared ? 0 : 2 * num_knots)) * sof_real);
+		if (!plan->pImpl) {
+			TS_THROW_0(try, err, status, TS_MALLOC,
+			           "out of memory")
+		}
+		plan->pImpl->deg = deg;
+		plan->pImpl->dim = dim;
+		plan->pImpl->n_ctrlp = num_ctrlp;
+		plan->pImpl->n_knots = num_knots;
+		plan->pImpl->knots = NULL;
+
+		/* Copy control points (dropping surplus components). */
+		ctrlp = ts_int_morphplan_access_ctrlp(plan);
+		from = ts_int_bspline_access_ctrlp(&origin_al);
 		for (i = 0; i < num_ctrlp; i++) {
-			for (d = 0; d < dim; d++) {
-				offset = i * dim + d;
-				ctrlp[offset] = t * target_al_c[offset] +
-				                t_hat * origin_al_c[offset];
-			}
+			memcpy(ctrlp, from + i * origin_dim, dim * sof_real);
+			ctrlp += dim;
+		}
+		from = ts_int_bspline_access_ctrlp(&target_al);
+		for (i = 0; i < num_ctrlp; i++) {
+			memcpy(ctrlp, from + i * target_dim, dim * sof_real);
+			ctrlp += dim;
 		}
 
-		/* Interpolate knots. */
-		for (i = 0; i < num_knots; i++) {
-			knots[i] = t * target_al_k[i] +
-			           t_hat * origin_al_k[i];
+		/* Copy knots. */
+		if (shared) {
+			TS_CALL(try, err, ts_int_block_share(
+			        shared, num_knots, &plan->pImpl->knots,
+			        status))
+		} else {
+			knots = ts_int_morphplan_access_knots(plan);
+			memcpy(knots,
+			       ts_int_bspline_access_knots(&origin_al),
+			       num_knots * sof_real);
+			memcpy(knots + num_knots,
+			       ts_int_bspline_access_knots(&target_al),
+			       num_knots * sof_real);
 		}
+	TS_CATCH(err)
+		ts_morphplan_free(plan);
 	TS_FINALLY
 		if (origin->pImpl != origin_al.pImpl)
 			ts_bspline_free(&origin_al);
@@ -2815,6 +5004,88 @@ ts_bspline_morph(const tsBSpline *origin,
 			ts_bspline_free(&target_al);
 	TS_END_TRY_RETURN(err)
 }
+
+void
+ts_morphplan_free(tsMorphPlan *plan)
+{
+	if (plan->pImpl) {
+		ts_int_block_release(plan->pImpl->knots);
+		free(plan->pImpl);
+	}
+	ts_int_morphplan_init(plan);
+}
+
+size_t
+ts_morphplan_degree(const tsMorphPlan *plan)
+{
+	return plan->pImpl->deg;
+}
+
+size_t
+ts_morphplan_dimension(const tsMorphPlan *plan)
+{
+	return plan->pImpl->dim;
+}
+
+size_t
+ts_morphplan_num_control_points(const tsMorphPlan *plan)
+{
+	return plan->pImpl->n_ctrlp;
+}
+
+tsError
+ts_morphplan_eval(const tsMorphPlan *plan,
+                  tsReal t,
+                  tsBSpline *out,
+                  tsStatus *status)
+{
+	const size_t dim = ts_morphplan_dimension(plan);
+	const size_t num_ctrlp = ts_morphplan_num_control_points(plan);
+	const size_t num_knots = plan->pImpl->n_knots;
+	const tsReal *ctrlp = ts_int_morphplan_access_ctrlp(plan);
+	struct tsBlock *shared = plan->pImpl->knots;
+	const tsReal *knots = shared ? ts_int_block_values(shared)
+	                             : ts_int_morphplan_access_knots(plan);
+
+	return ts_int_morph_blend(ctrlp, dim,
+	                          ctrlp + num_ctrlp * dim, dim,
+	                          knots, shared ? knots : knots + num_knots,
+	                          shared,
+	                          ts_morphplan_degree(plan),
+	                          num_ctrlp, t, out, status);
+}
+
+tsError
+ts_morphplan_eval_all(const tsMorphPlan *plan,
+                      const tsReal *t,
+                      size_t num,
+                      tsBSpline *out,
+                      tsStatus *status)
+{
+	size_t i;
+	tsError err;
+	for (i = 0; i < num; i++) {
+		TS_CALL_ROE(err, ts_morphplan_eval(
+		            plan, t[i], out + i, status))
+	}
+	TS_RETURN_SUCCESS(status)
+}
+
+tsError
+ts_morphplans_eval(const tsMorphPlan *plans,
+                   size_t num,
+                   tsReal t,
+                   tsBSpline *out,
+                   tsStatus *status)
+{
+	size_t i;
+	tsError err;
+	for (i = 0; i < num; i++) {
+		TS_CALL_ROE(err, ts_morphplan_eval(
+		            plans + i, t, out + i, status))
+	}
+	TS_RETURN_SUCCESS(status)
+}
 /*! @} */
 
 
@@ -3015,9 +5286,9 @@ ts_int_bspline_parse_json(const JSON_Value *spline_value,
 
 	/* Create spline. */
 	TS_TRY(try, err, status)
-		TS_CALL(try, err, ts_bspline_new(
+		TS_CALL(try, err, ts_int_bspline_new(
 		        len_ctrlp/dim, dim, deg,
-		        TS_CLAMPED, spline, status))
+		        TS_CLAMPED, 0, spline, status))
 		if (num_knots != ts_bspline_num_knots(spline))
 			TS_THROW_2(try, err, status, TS_NUM_KNOTS,
 			           "unexpected num(knots): (%lu) != (%lu)",
@@ -3025,7 +5296,7 @@ ts_int_bspline_parse_json(const JSON_Value *spline_value,
 			          (unsigned long) ts_bspline_num_knots(spline))
 
 		/* Set control points. */
-		ctrlp = ts_int_bspline_access_ctrlp(spline);
+		ctrlp = ts_int_bspline_unshared_ctrlp(spline);
 		for (i = 0; i < len_ctrlp; i++) {
 			real_value = json_array_get_value(ctrlp_array, i);
 			if (json_value_get_type(real_value) != JSONNumber)
@@ -3038,7 +5309,8 @@ ts_int_bspline_parse_json(const JSON_Value *spline_value,
 		        spline, ctrlp, status))
 
 		/* Set knots. */
-		knots = ts_int_bspline_access_knots(spline);
+		TS_CALL(try, err, ts_int_bspline_own_knots(
+		        spline, &knots, status))
 		for (i = 0; i < num_knots; i++) {
 			real_value = json_array_get_value(knots_array, i);
 			if (json_value_get_type(real_value) != JSONNumber)
@@ -3049,6 +5321,8 @@ ts_int_bspline_parse_json(const JSON_Value *spline_value,
 		}
 		TS_CALL(try, err, ts_bspline_set_knots(
 		        spline, knots, status))
+		/* Share the knots with equal splines (see ts_bspline_new). */
+		ts_int_block_intern(&spline->pImpl->knots);
 	TS_CATCH(err)
 		ts_bspline_free(spline);
 	TS_END_TRY_RETURN(err)
@@ -675,6 +675,60 @@ typedef struct
 	/** Binormal of the TNB-vector. */
 	tsReal binormal[3];
 } tsFrame;
+
+/**
+ * Scalar types a ::tsSink can store.
+ */
+typedef enum
+{
+	/** ::tsReal, i.e., no conversion. */
+	TS_SINK_REAL = 0,
+
+	/** \c float. Converts if tinyspline uses double precision. */
+	TS_SINK_FLOAT = 1,
+
+	/** \c double. Converts if tinyspline uses single precision. */
+	TS_SINK_DOUBLE = 2
+} tsSinkType;
+
+/**
+ * Describes a caller-owned buffer that evaluated points are written to (see,
+ * for example, ::ts_bspline_eval_all_sink). Point \c i is stored at
+ * <tt>(char *) data + offset + i * stride</tt> as \c dim consecutive scalars
+ * of type \c type. This allows to write points directly into arrays of
+ * interleaved vertex structs, e.g.:
+ *
+ *     typedef struct { float pos[3]; float uv[2]; } Vertex;
+ *     Vertex vertices[100];
+ *     tsSink sink;
+ *     sink.data = vertices;
+ *     sink.offset = offsetof(Vertex, pos);
+ *     sink.stride = sizeof(Vertex);
+ *     sink.dim = 3;
+ *     sink.type = TS_SINK_FLOAT;
+ *
+ * If \c dim is less than the dimensionality of the evaluated spline, the
+ * remaining components are dropped. If it is greater, the missing components
+ * are set to \c 0 (e.g., to store 2D points in 3D vertices).
+ */
+typedef struct
+{
+	/** The buffer. */
+	void *data;
+
+	/** Offset, in bytes, of the first point in \c data. */
+	size_t offset;
+
+	/** Distance, in bytes, between two consecutive points. If \c 0, the
+	 * points are tightly packed. */
+	size_t stride;
+
+	/** Number of scalars stored per point. */
+	size_t dim;
+
+	/** Type of the stored scalars. */
+	tsSinkType type;
+} tsSink;
 /*! @} */
 
 
@@ -686,6 +740,14 @@ typedef struct
  * details). The data of an instance can be accessed with the functions listed
  * in this section.
  *
+ * Control points and knots are reference counted and copied on write. That
+ * is, copies (see ::ts_bspline_copy) share their control points and knots with
+ * the original spline until either of them is changed. Knot vectors created by
+ * ::ts_bspline_new are interned: splines with the same type, degree, and
+ * number of control points share a single knot vector. Reference counts are
+ * updated atomically (if supported by the compiler), so that splines sharing
+ * data can be used from different threads.
+ *
  * @{
  */
 /**
@@ -793,10 +855,11 @@ ts_bspline_sof_control_points(const tsBSpline *spline);
  * return type of this function is \c const for a reason. Clients should only
  * read the returned array. When suppressing the constness and writing to the
  * array against better knowledge, the client is on its own with regard to the
- * consistency of the internal state of \p spline. If the control points of a
- * spline need to be changed, use ::ts_bspline_control_points to obtain a copy
- * of the control point array and ::ts_bspline_set_control_points to copy the
- * changed values back to the spline.
+ * consistency of the internal state of \p spline (and of all splines sharing
+ * the control points of \p spline). If the control points of a spline need
+ * to be changed, use ::ts_bspline_control_points to obtain a copy of the
+ * control point array and ::ts_bspline_set_control_points to copy the changed
+ * values back to the spline.
  *
  * @param[in] spline
  * 	The spline whose pointer to the control point array is returned.
@@ -867,6 +930,9 @@ ts_bspline_control_point_at_ptr(const tsBSpline *spline,
  * 	The status of this function. May be NULL.
  * @return TS_SUCCESS
  * 	On success.
+ * @return TS_MALLOC
+ * 	If the control points of \p spline are shared and allocating memory
+ * 	for a private copy failed.
  */
 tsError TINYSPLINE_API
 ts_bspline_set_control_points(tsBSpline *spline,
@@ -891,6 +957,9 @@ ts_bspline_set_control_points(tsBSpline *spline,
  * 	On success.
  * @return TS_INDEX_ERROR
  * 	If \p index is out of range.
+ * @return TS_MALLOC
+ * 	If the control points of \p spline are shared and allocating memory
+ * 	for a private copy failed.
  */
 tsError TINYSPLINE_API
 ts_bspline_set_control_point_at(tsBSpline *spline,
@@ -926,10 +995,10 @@ ts_bspline_sof_knots(const tsBSpline *spline);
  * type of this function is \c const for a reason. Clients should only read the
  * returned array. When suppressing the constness and writing to the array
  * against better knowledge, the client is on its own with regard to the
- * consistency of the internal state of \p spline. If the knot vector of a
- * spline needs to be changed, use ::ts_bspline_knots to obtain a copy of the
- * knot vector and ::ts_bspline_set_knots to copy the changed values back to
- * the spline.
+ * consistency of the internal state of \p spline (and of all splines sharing
+ * the knots of \p spline). If the knot vector of a spline needs to be
+ * changed, use ::ts_bspline_knots to obtain a copy of the knot vector and
+ * ::ts_bspline_set_knots to copy the changed values back to the spline.
  *
  * @param[in] spline
  * 	The spline whose pointer to the knot vector is returned.
@@ -998,6 +1067,9 @@ ts_bspline_knot_at(const tsBSpline *spline,
  * 	If the knot vector is decreasing.
  * @return TS_MULTIPLICITY
  * 	If there is a knot with multiplicity > order
+ * @return TS_MALLOC
+ * 	If the knots of \p spline are shared and allocating memory for a
+ * 	private copy failed.
  */
 tsError TINYSPLINE_API
 ts_bspline_set_knots(tsBSpline *spline,
@@ -1058,6 +1130,9 @@ ts_bspline_set_knots_varargs(tsBSpline *spline,
  * @return TS_MULTIPLICITY
  * 	If setting the knot at \p index results in a knot vector containing
  * 	\p knot with multiplicity greater than the order of \p spline.
+ * @return TS_MALLOC
+ * 	If the knots of \p spline are shared and allocating memory for a
+ * 	private copy failed.
  */
 tsError TINYSPLINE_API
 ts_bspline_set_knot_at(tsBSpline *spline,
@@ -1179,14 +1254,16 @@ ts_bspline_new_with_control_points(size_t num_control_points,
                                    ...);
 
 /**
- * Creates a deep copy of \p src and stores the copied data in \p dest. \p src
- * and \p dest can be the same instance.
+ * Creates a copy of \p src and stores the copied data in \p dest. \p src and
+ * \p dest can be the same instance. Runs in constant time: \p dest shares the
+ * control points and knots of \p src, which are copied as soon as either of
+ * the splines is changed.
  *
  * \b Note: Unlike \e memcpy and \e memmove, the first parameter is the source
  * and the second parameter is the destination.
  *
  * @param[in] src
- * 	The spline to be deep copied.
+ * 	The spline to be copied.
  * @param[out] dest
  * 	The output spline.
  * @param[out] status
@@ -1598,9 +1675,6 @@ ts_deboornet_free(tsDeBoorNet *net);
  * Given a set (or a sequence) of points, interpolate/approximate a spline that
  * follows these points.
  *
- * Note: Approximations have not yet been implemented. Pull requests are
- * welcome.
- *
  * @{
  */
 /**
@@ -1710,6 +1784,249 @@ ts_bspline_interpolate_catmull_rom(const tsReal *points,
                                    tsReal epsilon,
                                    tsBSpline *spline,
                                    tsStatus *status);
+
+/**
+ * Interpolates a (potentially unbounded) stream of points. Points are passed
+ * in chunks of arbitrary size with ::ts_streaminterp_push, which returns the
+ * bezier segments (degree \c 3) that have been finalized so far. After the
+ * last chunk, ::ts_streaminterp_finish returns the remaining segments. The
+ * memory used by a stream does not depend on the number of points pushed.
+ * The i'th segment of a stream has domain [i, i+1]. That is, the segments
+ * returned by successive calls can be concatenated without adjusting their
+ * knots. For example:
+ *
+ *     tsStreamInterp stream = ts_streaminterp_init();
+ *     tsBSpline segments;
+ *     size_t num;
+ *     ts_streaminterp_new_cubic_natural(2, 8, &stream, NULL);
+ *     while (...) {
+ *         ts_streaminterp_push(&stream, points, n, &segments, &num, NULL);
+ *         ... // consume `num' segments
+ *         ts_bspline_free(&segments);
+ *     }
+ *     ts_streaminterp_finish(&stream, &segments, &num, NULL);
+ *     ... // consume `num' segments
+ *     ts_bspline_free(&segments);
+ *     ts_streaminterp_free(&stream);
+ *
+ * The internal state of ::tsStreamInterp is protected using the PIMPL design
+ * pattern. It is recommended to initialize an instance with
+ * ::ts_streaminterp_init.
+ */
+typedef struct
+{
+	struct tsStreamInterpImpl *pImpl; /**< The actual implementation. */
+} tsStreamInterp;
+
+/**
+ * Creates a new stream whose data points to NULL.
+ *
+ * @return
+ * 	A new stream whose data points to NULL.
+ */
+tsStreamInterp TINYSPLINE_API
+ts_streaminterp_init(void);
+
+/**
+ * Creates a stream that interpolates a cubic spline with natural end
+ * conditions (see ::ts_bspline_interpolate_cubic_natural). The system of
+ * linear equations is solved on a sliding window of \p window points: the
+ * B-Spline control point of the newest point, which is not known yet, is
+ * estimated with the point itself and a segment is finalized as soon as
+ * \p window points have been pushed after its end point. The influence of the
+ * estimate decays by a factor of about 0.27 (2 - sqrt(3)) per point. Thus, the
+ * deviation from ::ts_bspline_interpolate_cubic_natural is bounded by about
+ * 0.27^window times the extent of the points in the window. The segments pass
+ * through the points exactly, whereas their first derivatives are continuous
+ * up to the same bound. If the total number of points is less than or equal
+ * to \p window + 1, the result is equal to
+ * ::ts_bspline_interpolate_cubic_natural (up to floating point errors).
+ *
+ * @param[in] dimension
+ * 	The dimensionality of the points.
+ * @param[in] window
+ * 	The number of points by which segments lag behind the pushed points.
+ * 	Values less than 1 are set to 1. A viable default value is 8.
+ * @param[out] stream
+ * 	The output stream.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_DIM_ZERO
+ * 	If \p dimension is 0.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_streaminterp_new_cubic_natural(size_t dimension,
+                                  size_t window,
+                                  tsStreamInterp *stream,
+                                  tsStatus *status);
+
+/**
+ * Creates a stream that interpolates a sequence of catmull-rom splines (see
+ * ::ts_bspline_interpolate_catmull_rom, whose \c first and \c last are
+ * generated). A segment is finalized as soon as the point after its end point
+ * has been pushed. The segments are equal to the ones created by
+ * ::ts_bspline_interpolate_catmull_rom.
+ *
+ * @param[in] dimension
+ * 	The dimensionality of the points.
+ * @param[in] alpha
+ * 	Knot parameterization: 0 => uniform, 0.5 => centripetal, 1 => chordal.
+ * 	The input value is clamped to the domain [0, 1].
+ * @param[in] epsilon
+ * 	The maximum distance between points with "same" coordinates (see
+ * 	::ts_bspline_interpolate_catmull_rom).
+ * @param[out] stream
+ * 	The output stream.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_DIM_ZERO
+ * 	If \p dimension is 0.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_streaminterp_new_catmull_rom(size_t dimension,
+                                tsReal alpha,
+                                tsReal epsilon,
+                                tsStreamInterp *stream,
+                                tsStatus *status);
+
+/**
+ * Pushes \p num_points points into \p stream and stores the segments that
+ * have been finalized by these points in \p segments (a sequence of bezier
+ * curves). If no segment has been finalized, the data of \p segments points to
+ * NULL. \p segments is not released before being overridden.
+ *
+ * @param[in, out] stream
+ * 	The stream.
+ * @param[in] points
+ * 	The points to be pushed.
+ * @param[in] num_points
+ * 	The number of points in \p points.
+ * @param[out] segments
+ * 	The finalized segments.
+ * @param[out] num_segments
+ * 	The number of segments in \p segments.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_NUM_KNOTS
+ * 	If the number of finalized segments exceeds ::TS_MAX_NUM_KNOTS (in
+ * 	this case, \p stream is not modified and \p points should be pushed in
+ * 	smaller chunks).
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_streaminterp_push(tsStreamInterp *stream,
+                     const tsReal *points,
+                     size_t num_points,
+                     tsBSpline *segments,
+                     size_t *num_segments,
+                     tsStatus *status);
+
+/**
+ * Stores the remaining segments of \p stream in \p segments and resets \p
+ * stream such that it can be used for another sequence of points. If only a
+ * single point has been pushed, a cubic point (i.e., a spline with four times
+ * the same control point) is created. \p segments is not released before
+ * being overridden.
+ *
+ * @param[in, out] stream
+ * 	The stream.
+ * @param[out] segments
+ * 	The remaining segments.
+ * @param[out] num_segments
+ * 	The number of segments in \p segments.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_NUM_POINTS
+ * 	If no point has been pushed.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_streaminterp_finish(tsStreamInterp *stream,
+                       tsBSpline *segments,
+                       size_t *num_segments,
+                       tsStatus *status);
+
+/**
+ * Releases the data of \p stream. After calling this function, the data of \p
+ * stream points to NULL.
+ *
+ * @param[out] stream
+ * 	The stream to be released.
+ */
+void TINYSPLINE_API
+ts_streaminterp_free(tsStreamInterp *stream);
+
+/**
+ * Approximates \p points with a clamped spline of degree \p degree using a
+ * least squares fit (see 'The NURBS Book', Section 9.4.1). The points are
+ * parameterized by their chord length and the first and last point are
+ * interpolated exactly. Starting with a single bezier curve, knots are
+ * inserted into all spans whose maximum error (i.e., the euclidean distance
+ * between a point and the spline evaluated at the point's parameter) exceeds
+ * \p tolerance, and the spline is fitted again. This process continues until
+ * either \p tolerance is met or none of the spans can be refined any further
+ * (a span must contain at least `degree + 1' points in order to be split).
+ * In the latter case, the best fit is returned nonetheless and \p max_error
+ * is greater than \p tolerance. The number of control points of \p spline
+ * never exceeds \p num_points.
+ *
+ * @param[in] points
+ * 	The points to be approximated.
+ * @param[in] num_points
+ * 	The number of points in \p points.
+ * @param[in] dimension
+ * 	The dimensionality of the points.
+ * @param[in] degree
+ * 	The degree of \p spline. A value less than 1 is set to 1.
+ * @param[in] tolerance
+ * 	The maximum error allowed between \p points and \p spline. For the
+ * 	sake of fail-safeness, the sign is removed with fabs.
+ * @param[out] spline
+ * 	The approximated spline.
+ * @param[out] max_error
+ * 	The maximum error between \p points and \p spline. May be NULL.
+ * @param[out] compression
+ * 	The ratio of \p num_points to the number of control points of
+ * 	\p spline. May be NULL.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_DIM_ZERO
+ * 	If \p dimension is 0.
+ * @return TS_NUM_POINTS
+ * 	If \p num_points is 0.
+ * @return TS_DEG_GE_NCTRLP
+ * 	If \p num_points <= \p degree.
+ * @return TS_NO_RESULT
+ * 	If the initial bezier fit is singular.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_approximate(const tsReal *points,
+                       size_t num_points,
+                       size_t dimension,
+                       size_t degree,
+                       tsReal tolerance,
+                       tsBSpline *spline,
+                       tsReal *max_error,
+                       tsReal *compression,
+                       tsStatus *status);
 /*! @} */
 
 
@@ -1816,6 +2133,408 @@ ts_bspline_sample(const tsBSpline *spline,
                   size_t *actual_num,
                   tsStatus *status);
 
+/**
+ * Sink counterpart of ::ts_bspline_eval_all. Instead of allocating a new
+ * array, the evaluated points are written to \p sink (see ::tsSink).
+ *
+ * @pre \p sink can hold \p num points.
+ * @param[in] spline
+ * 	The spline to evaluate.
+ * @param[in] knots
+ * 	The knot values to evaluate.
+ * @param[in] num
+ * 	The number of knots in \p knots.
+ * @param[out] sink
+ * 	Stores the evaluated points.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_U_UNDEFINED
+ * 	If \p spline is not defined at one of the knot values in \p knots.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_eval_all_sink(const tsBSpline *spline,
+                         const tsReal *knots,
+                         size_t num,
+                         const tsSink *sink,
+                         tsStatus *status);
+
+/**
+ * Sink counterpart of ::ts_bspline_sample. Evaluates \p spline at \p num
+ * knots generated with ::ts_bspline_uniform_knot_seq and writes the points
+ * to \p sink (see ::tsSink). Neither the knots nor the points are stored in
+ * intermediate arrays. Unlike ::ts_bspline_sample, there is no fallback if
+ * \p num is 0, i.e., nothing is written.
+ *
+ * @pre \p sink can hold \p num points.
+ * @param[in] spline
+ * 	The spline to evaluate.
+ * @param[in] num
+ * 	The number of knots to be generated.
+ * @param[out] sink
+ * 	Stores the evaluated points.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_sample_sink(const tsBSpline *spline,
+                       size_t num,
+                       const tsSink *sink,
+                       tsStatus *status);
+
+/**
+ * Evaluates the point and the first \p n derivatives of \p spline at \p knot
+ * in a single pass over the non-vanishing basis functions (and their
+ * derivatives) of the knot span containing \p knot. The implementation is
+ * based on algorithm A2.3 of 'The NURBS Book' (Les Piegl and Wayne Tiller).
+ * In contrast to ::ts_bspline_derive, no derivative splines are created.
+ *
+ * The result is stored in \p derivs as follows:
+ *
+ *     [C(u), C'(u), C''(u), ..., C^(n)(u)]
+ *
+ * where each entry has dimensionality <tt>ts_bspline_dimension(spline)</tt>.
+ * Derivatives of order greater than the degree of \p spline are \c 0. If \p
+ * spline is discontinuous at \p knot (i.e., the multiplicity of \p knot is
+ * equal to the order of \p spline), or if its first derivative is (i.e., the
+ * multiplicity is equal to the degree), the left-hand limit is evaluated,
+ * consistent with ::ts_bspline_eval. Note that homogeneous coordinates
+ * (NURBS) are not projected, that is, the derivatives of the homogeneous
+ * curve are returned.
+ *
+ * @pre
+ * 	\p derivs has length <tt>(n + 1) * ts_bspline_dimension(spline)</tt>.
+ * @param[in] spline
+ * 	The spline to evaluate.
+ * @param[in] knot
+ * 	The knot to evaluate \p spline at.
+ * @param[in] n
+ * 	The number of derivatives to evaluate. If \c 0, only the point at \p
+ * 	knot is evaluated.
+ * @param[out] derivs
+ * 	Stores the point and the derivatives at \p knot.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_U_UNDEFINED
+ * 	If \p spline is not defined at \p knot.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_eval_derivs(const tsBSpline *spline,
+                       tsReal knot,
+                       size_t n,
+                       tsReal *derivs,
+                       tsStatus *status);
+
+/**
+ * Like ::ts_bspline_eval_derivs, but evaluates \p spline at each knot in \p
+ * knots. The working memory of the evaluation is allocated only once and
+ * reused for all knots. The results are stored consecutively in \p derivs,
+ * that is, the point and the derivatives at <tt>knots[i]</tt> start at:
+ *
+ *     derivs + i * (n + 1) * ts_bspline_dimension(spline)
+ *
+ * @pre
+ * 	\p derivs has length
+ * 	<tt>num * (n + 1) * ts_bspline_dimension(spline)</tt>.
+ * @param[in] spline
+ * 	The spline to evaluate.
+ * @param[in] knots
+ * 	The knots to evaluate \p spline at.
+ * @param[in] num
+ * 	Number of knots in \p knots.
+ * @param[in] n
+ * 	The number of derivatives to evaluate at each knot.
+ * @param[out] derivs
+ * 	Stores the points and the derivatives at \p knots.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_U_UNDEFINED
+ * 	If \p spline is not defined at one of the knots in \p knots.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_eval_derivs_all(const tsBSpline *spline,
+                           const tsReal *knots,
+                           size_t num,
+                           size_t n,
+                           tsReal *derivs,
+                           tsStatus *status);
+
+/**
+ * Evaluates the point and the first \p n derivatives of the rational spline
+ * (NURBS) \p spline at \p knot. The control points of \p spline are expected
+ * to be in homogeneous coordinates, that is, the last component of each
+ * control point is the weight (see ::tsBSpline). The derivatives of the
+ * homogeneous curve are evaluated with the same kernel as
+ * ::ts_bspline_eval_derivs and are immediately projected into Cartesian
+ * space, i.e., the division by the weight and the quotient rule for rational
+ * derivatives (algorithm A4.2 of 'The NURBS Book') are applied per knot.
+ * Thus, there is no need to divide the results in a second pass.
+ *
+ * The result is stored in \p derivs as follows:
+ *
+ *     [C(u), C'(u), C''(u), ..., C^(n)(u)]
+ *
+ * where each entry has dimensionality
+ * <tt>ts_bspline_dimension(spline) - 1</tt>. If \p n is \c 0, only the
+ * (projected) point at \p knot is evaluated. Unlike non-rational splines,
+ * the derivatives of a rational spline do not vanish if \p n is greater than
+ * the degree of \p spline. Discontinuities are handled like in
+ * ::ts_bspline_eval_derivs.
+ *
+ * @pre
+ * 	\p derivs has length
+ * 	<tt>(n + 1) * (ts_bspline_dimension(spline) - 1)</tt>.
+ * @pre
+ * 	The weights of \p spline are not \c 0 at \p knot.
+ * @param[in] spline
+ * 	The rational spline to evaluate.
+ * @param[in] knot
+ * 	The knot to evaluate \p spline at.
+ * @param[in] n
+ * 	The number of derivatives to evaluate.
+ * @param[out] derivs
+ * 	Stores the projected point and derivatives at \p knot.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_DIM_ZERO
+ * 	If the dimensionality of \p spline is less than \c 2 (the projected
+ * 	points would have dimensionality \c 0).
+ * @return TS_U_UNDEFINED
+ * 	If \p spline is not defined at \p knot.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_eval_derivs_rational(const tsBSpline *spline,
+                                tsReal knot,
+                                size_t n,
+                                tsReal *derivs,
+                                tsStatus *status);
+
+/**
+ * Like ::ts_bspline_eval_derivs_rational, but evaluates \p spline at each
+ * knot in \p knots. The working memory of the evaluation is allocated only
+ * once and reused for all knots. The results are stored consecutively in \p
+ * derivs, that is, the point and the derivatives at <tt>knots[i]</tt> start
+ * at:
+ *
+ *     derivs + i * (n + 1) * (ts_bspline_dimension(spline) - 1)
+ *
+ * @pre
+ * 	\p derivs has length
+ * 	<tt>num * (n + 1) * (ts_bspline_dimension(spline) - 1)</tt>.
+ * @param[in] spline
+ * 	The rational spline to evaluate.
+ * @param[in] knots
+ * 	The knots to evaluate \p spline at.
+ * @param[in] num
+ * 	Number of knots in \p knots.
+ * @param[in] n
+ * 	The number of derivatives to evaluate at each knot.
+ * @param[out] derivs
+ * 	Stores the projected points and derivatives at \p knots.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_DIM_ZERO
+ * 	If the dimensionality of \p spline is less than \c 2.
+ * @return TS_U_UNDEFINED
+ * 	If \p spline is not defined at one of the knots in \p knots.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_eval_derivs_all_rational(const tsBSpline *spline,
+                                    const tsReal *knots,
+                                    size_t num,
+                                    size_t n,
+                                    tsReal *derivs,
+                                    tsStatus *status);
+
+/**
+ * Rational counterpart of ::ts_bspline_eval_all. Evaluates the rational
+ * spline (NURBS) \p spline at each knot in \p knots and stores the projected
+ * points in \p points. After calling this function \p points contains
+ * exactly \code num * (ts_bspline_dimension(spline) - 1) \endcode values.
+ * Like ::ts_bspline_eval_all, the left-hand point is evaluated at knots where
+ * \p spline is discontinuous (e.g., between the segments of piecewise Bezier
+ * conics that do not share their end points).
+ *
+ * @param[in] spline
+ * 	The rational spline to evaluate.
+ * @param[in] knots
+ * 	The knot values to evaluate.
+ * @param[in] num
+ * 	The number of knots in \p knots.
+ * @param[out] points
+ * 	The output parameter.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_DIM_ZERO
+ * 	If the dimensionality of \p spline is less than \c 2.
+ * @return TS_U_UNDEFINED
+ * 	If \p spline is not defined at one of the knot values in \p knots.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_eval_all_rational(const tsBSpline *spline,
+                             const tsReal *knots,
+                             size_t num,
+                             tsReal **points,
+                             tsStatus *status);
+
+/**
+ * Rational counterpart of ::ts_bspline_sample. Generates a sequence of \p num
+ * different knots (see ::ts_bspline_uniform_knot_seq), passes this sequence
+ * to ::ts_bspline_eval_all_rational, and stores the resultant (projected)
+ * points in \p points. If \p num is 0, the default value \c 100 is used as
+ * fallback.
+ *
+ * @param[in] spline
+ * 	The rational spline to be evaluate.
+ * @param[in] num
+ * 	The number of knots to be generate.
+ * @param[out] points
+ * 	The output parameter.
+ * @param[out] actual_num
+ * 	The actual number of generated knots. Differs from \p num only if
+ * 	\p num is 0. Must not be NULL.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_DIM_ZERO
+ * 	If the dimensionality of \p spline is less than \c 2.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_sample_rational(const tsBSpline *spline,
+                           size_t num,
+                           tsReal **points,
+                           size_t *actual_num,
+                           tsStatus *status);
+
+/**
+ * Computes the speed (i.e., the magnitude of the first derivative) of \p
+ * spline at each knot in \p knots. The derivatives are evaluated with
+ * ::ts_bspline_eval_derivs_all.
+ *
+ * @pre \p knots and \p speeds have length \p num.
+ * @param[in] spline
+ * 	The spline to query.
+ * @param[in] knots
+ * 	The knots to evaluate \p spline at.
+ * @param[in] num
+ * 	Number of knots in \p knots.
+ * @param[out] speeds
+ * 	<tt>speeds[i]</tt> is the speed of \p spline at <tt>knots[i]</tt>.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_U_UNDEFINED
+ * 	If \p spline is not defined at one of the knots in \p knots.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_speed(const tsBSpline *spline,
+                 const tsReal *knots,
+                 size_t num,
+                 tsReal *speeds,
+                 tsStatus *status);
+
+/**
+ * Computes the curvature of \p spline at each knot in \p knots:
+ *
+ *     sqrt(|C'|^2 * |C''|^2 - (C' . C'')^2) / |C'|^3
+ *
+ * This formula is valid for any dimensionality. If the speed of \p spline at
+ * a knot is less than ::TS_LENGTH_ZERO, the curvature at this knot is \c 0.
+ *
+ * @pre \p knots and \p curvatures have length \p num.
+ * @param[in] spline
+ * 	The spline to query.
+ * @param[in] knots
+ * 	The knots to evaluate \p spline at.
+ * @param[in] num
+ * 	Number of knots in \p knots.
+ * @param[out] curvatures
+ * 	<tt>curvatures[i]</tt> is the curvature of \p spline at
+ * 	<tt>knots[i]</tt>.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_U_UNDEFINED
+ * 	If \p spline is not defined at one of the knots in \p knots.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_curvature(const tsBSpline *spline,
+                     const tsReal *knots,
+                     size_t num,
+                     tsReal *curvatures,
+                     tsStatus *status);
+
+/**
+ * Computes the torsion of \p spline at each knot in \p knots:
+ *
+ *     ((C' x C'') . C''') / |C' x C''|^2
+ *
+ * Only the first three components of the derivatives are taken into account.
+ * Splines with a dimensionality less than \c 3 are treated as if they were
+ * embedded in the xy-plane (with torsion \c 0). If the magnitude of
+ * <tt>C' x C''</tt> is less than ::TS_LENGTH_ZERO, the torsion is \c 0.
+ *
+ * @pre \p knots and \p torsions have length \p num.
+ * @param[in] spline
+ * 	The spline to query.
+ * @param[in] knots
+ * 	The knots to evaluate \p spline at.
+ * @param[in] num
+ * 	Number of knots in \p knots.
+ * @param[out] torsions
+ * 	<tt>torsions[i]</tt> is the torsion of \p spline at <tt>knots[i]</tt>.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_U_UNDEFINED
+ * 	If \p spline is not defined at one of the knots in \p knots.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_torsion(const tsBSpline *spline,
+                   const tsReal *knots,
+                   size_t num,
+                   tsReal *torsions,
+                   tsStatus *status);
+
 /**
  * Tries to find a point P on \p spline such that:
  *
@@ -2004,6 +2723,82 @@ ts_bspline_compute_rmf(const tsBSpline *spline,
                        tsFrame *frames,
                        tsStatus *status);
 
+/**
+ * Sweeps the cross-section \p profile along \p spline and stores the
+ * resultant mesh in \p vertices, \p normals, and \p indices. The frames of
+ * the sweep are computed with the double reflection method (see
+ * ::ts_bspline_compute_rmf) at \p num_steps uniformly distributed knots, and
+ * each ring of the mesh is emitted as soon as its frame is available. That
+ * is, no array of frames is created. If \p max_angle is greater than \c 0,
+ * rings are placed adaptively: Apart from the first and last step, a ring is
+ * emitted only if the tangent turned by more than \p max_angle (radians)
+ * since the last ring. Straight sections thus get only a few rings, whereas
+ * curved sections get up to one ring per step. If \p max_angle is \c 0, a
+ * ring is emitted at every step.
+ *
+ * A profile point (x, y) is placed at <tt>position + x * normal + y *
+ * binormal</tt> of the corresponding frame. Vertex normals are derived from
+ * the edges of \p profile, which should wind counter-clockwise for the
+ * normals (and triangles) to face outwards. Ring \c r, profile point \c i is
+ * stored at index <tt>r * num_profile + i</tt>. Each quad between two rings
+ * is split into two counter-clockwise triangles. Vertices and normals are
+ * written to sinks (see ::tsSink) so that, for example, they can be stored
+ * directly in an interleaved single precision vertex buffer.
+ *
+ * @pre
+ * 	\p vertices and \p normals can hold at least
+ * 	<tt>num_steps * num_profile</tt> points; \p indices has at least
+ * 	<tt>(num_steps - 1) * num_quads * 6</tt> entries, where \c num_quads
+ * 	is \p num_profile if \p closed and <tt>num_profile - 1</tt> otherwise.
+ * 	The number of entries actually written follows from \p num_rings.
+ * @param[in] spline
+ * 	The spline to sweep along.
+ * @param[in] profile
+ * 	The 2D cross-section to sweep.
+ * @param[in] num_profile
+ * 	The number of points in \p profile.
+ * @param[in] closed
+ * 	Whether \p profile is a closed loop (tube) or an open polyline
+ * 	(ribbon).
+ * @param[in] num_steps
+ * 	The number of frames to compute. A value less than 2 is set to 2.
+ * @param[in] max_angle
+ * 	Adaptive ring spacing, see description. For the sake of fail-safeness,
+ * 	the sign is removed with fabs.
+ * @param[out] vertices
+ * 	Stores the vertices (3D) of the mesh (see ::tsSink).
+ * @param[out] normals
+ * 	Stores the normals (3D) of the mesh (see ::tsSink). May be NULL.
+ * @param[out] indices
+ * 	Stores the triangles of the mesh. May be NULL. The indices have a fixed
+ * 	width so that they can be uploaded to the GPU as they are.
+ * @param[out] num_rings
+ * 	The number of rings stored in \p vertices.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_NUM_POINTS
+ * 	If \p num_profile is less than 2.
+ * @return TS_NUM_POINTS
+ * 	If \p indices is not NULL and <tt>num_steps * num_profile</tt> vertices
+ * 	cannot be addressed with an unsigned int.
+ * @return TS_MALLOC
+ * 	If memory allocation failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_sweep(const tsBSpline *spline,
+                 const tsReal *profile,
+                 size_t num_profile,
+                 int closed,
+                 size_t num_steps,
+                 tsReal max_angle,
+                 const tsSink *vertices,
+                 const tsSink *normals,
+                 unsigned int *indices,
+                 size_t *num_rings,
+                 tsStatus *status);
+
 /**
  * Computes the cumulative chord lengths of the points of the given
  * knots. Note that the first length (i.e., <tt>lengths[0]</tt>) is
@@ -2269,6 +3064,50 @@ ts_bspline_insert_knot(const tsBSpline *spline,
                        size_t *k,
                        tsStatus *status);
 
+/**
+ * Inserts all knots of \p knots into the knot vector of \p spline in a single
+ * pass (knot refinement, see The NURBS Book, Algorithm A5.4). In contrast to
+ * calling ::ts_bspline_insert_knot for each knot, the control points and knots
+ * of \p result are allocated only once and each control point is computed
+ * only once, which reduces the cost of inserting \c r knots into a spline with
+ * \c n control points from O(r * n) to O(n + r * degree). \p knots must be
+ * sorted in ascending order and may contain duplicates. Knots that are equal
+ * (see ::ts_knots_equal) to a knot of \p spline or to a preceding knot of \p
+ * knots are snapped to the latter. If \p spline != \p result, the internal
+ * state of \p spline is not modified, that is, \p result is a new,
+ * independent ::tsBSpline instance.
+ *
+ * @param[in] spline
+ * 	The spline to be refined.
+ * @param[in] knots
+ * 	The knots to be inserted (sorted in ascending order).
+ * @param[in] num
+ * 	Number of knots in \p knots.
+ * @param[out] result
+ * 	The output spline.
+ * @param status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_U_UNDEFINED
+ * 	If a knot of \p knots is not within the domain of \p spline.
+ * @return TS_KNOTS_DECR
+ * 	If \p knots is not sorted in ascending order.
+ * @return TS_MULTIPLICITY
+ * 	If the multiplicity of a knot in \p result would be greater than the
+ * 	order of \p spline.
+ * @return TS_NUM_KNOTS
+ * 	If \p result would have more than ::TS_MAX_NUM_KNOTS knots.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_bspline_refine_knots(const tsBSpline *spline,
+                        const tsReal *knots,
+                        size_t num,
+                        tsBSpline *result,
+                        tsStatus *status);
+
 /**
  * Splits \p spline at \p knot. That is, \p knot is inserted into \p spline \c
  * n times such that the multiplicity of \p knot is equal the spline's order.
@@ -2480,7 +3319,8 @@ ts_bspline_align(const tsBSpline *s1,
  *
  * It should be noted that this function, if necessary, aligns \p origin and \p
  * target using ::ts_bspline_align. In order to avoid the overhead of spline
- * alignment, \p origin and \p target should be aligned in advance.
+ * alignment, \p origin and \p target should be aligned in advance (see
+ * ::tsMorphPlan).
  *
  * @param[in] origin
  * 	Origin spline.
@@ -2513,6 +3353,208 @@ ts_bspline_morph(const tsBSpline *origin,
 
 
 
+/*! @name Morph Plan
+ *
+ * ::ts_bspline_morph aligns its input splines (see ::ts_bspline_align) on
+ * every call, which is expensive if the same pair of splines is blended over
+ * and over again (e.g., to animate a transition). A ::tsMorphPlan aligns the
+ * splines once and caches the aligned control points and knots, so that each
+ * subsequent blend costs a single pass over the control points and knots. For
+ * example:
+ *
+ *     tsReal t;
+ *     tsBSpline origin = ...
+ *     tsBSpline target = ...
+ *     tsBSpline morph = ts_bspline_init();
+ *     tsMorphPlan plan = ts_morphplan_init();
+ *     ts_morphplan_new(&origin, &target, TS_POINT_EPSILON, &plan, NULL);
+ *     for (t = (tsReal) 0.0; t <= (tsReal) 1.0; t += (tsReal) 0.001)
+ *         ts_morphplan_eval(&plan, t, &morph, NULL);
+ *     ts_morphplan_free(&plan);
+ *     ts_bspline_free(&morph);
+ *
+ * The internal state of ::tsMorphPlan is protected using the PIMPL design
+ * pattern. As with ::tsBSpline and ::tsDeBoorNet, it is recommended to
+ * initialize an instance with ::ts_morphplan_init.
+ *
+ * @{
+ */
+/**
+ * Stores the aligned control points and knots of two splines that are to be
+ * blended with ::ts_morphplan_eval.
+ */
+typedef struct
+{
+	struct tsMorphPlanImpl *pImpl; /**< The actual implementation. */
+} tsMorphPlan;
+
+/**
+ * Creates a new plan whose data points to NULL.
+ *
+ * @return
+ * 	A new plan whose data points to NULL.
+ */
+tsMorphPlan TINYSPLINE_API
+ts_morphplan_init(void);
+
+/**
+ * Aligns \p origin and \p target (if necessary) and stores the aligned control
+ * points and knots in \p plan. If the dimensions of \p origin and \p target
+ * differ, the surplus components of the control points of the spline with the
+ * higher dimension are dropped. The internal state of \p origin and \p target
+ * is not modified.
+ *
+ * @param[in] origin
+ * 	Origin spline.
+ * @param[in] target
+ * 	Target spline.
+ * @param[in] epsilon
+ * 	Passed to ::ts_bspline_align if \p origin and \p target must be
+ * 	aligned. A viable default value is ::TS_POINT_EPSILON.
+ * @param[out] plan
+ * 	The output plan.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_morphplan_new(const tsBSpline *origin,
+                 const tsBSpline *target,
+                 tsReal epsilon,
+                 tsMorphPlan *plan,
+                 tsStatus *status);
+
+/**
+ * Releases the data of \p plan. After calling this function, the data of \p
+ * plan points to NULL.
+ *
+ * @param[out] plan
+ * 	The plan to be released.
+ */
+void TINYSPLINE_API
+ts_morphplan_free(tsMorphPlan *plan);
+
+/**
+ * Returns the degree of the splines blended by \p plan.
+ *
+ * @param[in] plan
+ * 	The plan whose degree is read.
+ * @return
+ * 	The degree of the splines blended by \p plan.
+ */
+size_t TINYSPLINE_API
+ts_morphplan_degree(const tsMorphPlan *plan);
+
+/**
+ * Returns the dimensionality of the splines created by \p plan.
+ *
+ * @param[in] plan
+ * 	The plan whose dimension is read.
+ * @return
+ * 	The dimensionality of the splines created by \p plan.
+ */
+size_t TINYSPLINE_API
+ts_morphplan_dimension(const tsMorphPlan *plan);
+
+/**
+ * Returns the number of control points of the splines created by \p plan.
+ *
+ * @param[in] plan
+ * 	The plan whose number of control points is read.
+ * @return
+ * 	The number of control points of the splines created by \p plan.
+ */
+size_t TINYSPLINE_API
+ts_morphplan_num_control_points(const tsMorphPlan *plan);
+
+/**
+ * Blends the splines of \p plan with respect to the time parameter \p t
+ * (domain: [0, 1]; clamped if necessary) and stores the result in \p out.
+ * Like ::ts_bspline_morph, memory for \p out is allocated only if it points to
+ * NULL or if its degree, dimension, or number of control points does not match
+ * the splines of \p plan. That is, once \p out has been set up, this function
+ * does not allocate any memory.
+ *
+ * @param[in] plan
+ * 	The plan to evaluate.
+ * @param[in] t
+ * 	The time parameter. If 0, \p out becomes the aligned origin. If 1, \p out
+ * 	becomes the aligned target.
+ * @param[out] out
+ * 	The resulting spline.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_morphplan_eval(const tsMorphPlan *plan,
+                  tsReal t,
+                  tsBSpline *out,
+                  tsStatus *status);
+
+/**
+ * Evaluates \p plan for each time parameter in \p t (see
+ * ::ts_morphplan_eval) and stores the i'th result in the i'th spline of \p
+ * out.
+ *
+ * @param[in] plan
+ * 	The plan to evaluate.
+ * @param[in] t
+ * 	The time parameters.
+ * @param[in] num
+ * 	Number of values in \p t and splines in \p out.
+ * @param[out] out
+ * 	The resulting splines.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_morphplan_eval_all(const tsMorphPlan *plan,
+                      const tsReal *t,
+                      size_t num,
+                      tsBSpline *out,
+                      tsStatus *status);
+
+/**
+ * Evaluates each plan of \p plans at the time parameter \p t (see
+ * ::ts_morphplan_eval) and stores the i'th result in the i'th spline of \p
+ * out.
+ *
+ * @param[in] plans
+ * 	The plans to evaluate.
+ * @param[in] num
+ * 	Number of plans in \p plans and splines in \p out.
+ * @param[in] t
+ * 	The time parameter.
+ * @param[out] out
+ * 	The resulting splines.
+ * @param[out] status
+ * 	The status of this function. May be NULL.
+ * @return TS_SUCCESS
+ * 	On success.
+ * @return TS_MALLOC
+ * 	If allocating memory failed.
+ */
+tsError TINYSPLINE_API
+ts_morphplans_eval(const tsMorphPlan *plans,
+                   size_t num,
+                   tsReal t,
+                   tsBSpline *out,
+                   tsStatus *status);
+/*! @} */
+
+
+
 /*! @name Serialization and Persistence
  *
  * The following functions can be used to serialize and persist (i.e., store
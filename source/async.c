@@ -0,0 +1,177 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "async.h"
+
+// compute the job in job_input into back
+// 	back must not be visible to the render thread
+bool async_run (async_t* async)
+{
+	if (async->release)
+	{
+		async->release (async->back);
+	}
+	memset (async->back, 0, async->result_size);
+
+	return async->compute (async, async->job_input, async->back);
+}
+
+void* async_worker (void* data)
+{
+	async_t* async = data;
+
+	pthread_mutex_lock (&async->mutex);
+	while (true)
+	{
+		// a finished result stays in back until the render thread has swapped it out
+		while (!async->quit && (async->started == async->posted || async->ready))
+		{
+			pthread_cond_wait (&async->condition, &async->mutex);
+		}
+		if (async->quit)
+		{
+			break;
+		}
+
+		// take the newest input
+		// 	anything posted before it never runs
+		memcpy (async->job_input, async->input, async->input_size);
+		async->started = async->posted;
+		pthread_mutex_unlock (&async->mutex);
+
+		// back is not visible to the render thread while we are writing to it
+		bool complete = async_run (async);
+
+		pthread_mutex_lock (&async->mutex);
+		async->ready = complete;
+		async->skipped = !complete;
+	}
+	pthread_mutex_unlock (&async->mutex);
+
+	return NULL;
+}
+
+// returns false if the worker thread could not be started
+// 	async_post then computes synchronously on the calling thread
+// 	if not even the buffers could be allocated, nothing is computed and async_result stays NULL
+bool async_initialize (async_t* async, size_t input_size, size_t result_size, async_compute compute, async_release release)
+{
+	async->compute = compute;
+	async->release = release;
+	async->input_size = input_size;
+	async->result_size = result_size;
+
+	async->input = calloc (1, input_size);
+	async->job_input = calloc (1, input_size);
+	async->front = calloc (1, result_size);
+	async->back = calloc (1, result_size);
+
+	async->posted = 0;
+	async->started = 0;
+	async->has_front = false;
+	async->ready = false;
+	async->skipped = false;
+	async->quit = false;
+	async->allocated = async->input && async->job_input && async->front && async->back;
+	async->threaded = false;
+
+	pthread_mutex_init (&async->mutex, NULL);
+	pthread_cond_init (&async->condition, NULL);
+	if (async->allocated)
+	{
+		async->threaded = pthread_create (&async->thread, NULL, async_worker, async) == 0;
+	}
+
+	return async->threaded;
+}
+
+void async_post (async_t* async, const void* input)
+{
+	if (!async->allocated)
+	{
+		return;
+	}
+	if (!async->threaded)
+	{
+		// without a worker the job runs right away, async_synchronize publishes it as usual
+		memcpy (async->job_input, input, async->input_size);
+		async->posted++;
+		async->started = async->posted;
+		async->ready = async_run (async);
+		async->skipped = !async->ready;
+		return;
+	}
+
+	pthread_mutex_lock (&async->mutex);
+	memcpy (async->input, input, async->input_size);
+	async->posted++;
+	pthread_cond_signal (&async->condition);
+	pthread_mutex_unlock (&async->mutex);
+}
+
+// call once per frame before reading async_result
+// 	returns true if a new result was swapped to the front
+bool async_synchronize (async_t* async)
+{
+	bool swapped = false;
+
+	pthread_mutex_lock (&async->mutex);
+	if (async->ready)
+	{
+		void* swap = async->front;
+		async->front = async->back;
+		async->back = swap;
+		async->ready = false;
+		async->has_front = true;
+		swapped = true;
+		// the worker may be waiting for back to become free
+		pthread_cond_signal (&async->condition);
+	}
+	pthread_mutex_unlock (&async->mutex);
+
+	return swapped;
+}
+
+// NULL until the first result has been synchronized
+const void* async_result (async_t* async)
+{
+	return async->has_front ? async->front : NULL;
+}
+
+// true if a newer input was posted while the current job was running
+// 	a cancelled job is never followed by another cancelled job
+// 	so a steady stream of posts (dragging a point) can not starve the result
+bool async_cancelled (async_t* async)
+{
+	pthread_mutex_lock (&async->mutex);
+	bool cancelled = async->quit || (async->started != async->posted && !async->skipped);
+	pthread_mutex_unlock (&async->mutex);
+
+	return cancelled;
+}
+
+void async_cleanup (async_t* async)
+{
+	if (async->threaded)
+	{
+		pthread_mutex_lock (&async->mutex);
+		async->quit = true;
+		pthread_cond_signal (&async->condition);
+		pthread_mutex_unlock (&async->mutex);
+
+		pthread_join (async->thread, NULL);
+	}
+	pthread_cond_destroy (&async->condition);
+	pthread_mutex_destroy (&async->mutex);
+
+	if (async->release && async->allocated)
+	{
+		async->release (async->front);
+		async->release (async->back);
+	}
+
+	free (async->input);
+	free (async->job_input);
+	free (async->front);
+	free (async->back);
+}
@@ -0,0 +1,64 @@
+#ifndef _async_h_
+#define _async_h_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+
+// a compute stage that runs spline work on a worker thread
+// 	the render thread posts inputs and picks up finished results at frame boundaries
+// 	so it never has to wait on the spline math
+//
+// inputs are copied when posted
+// 	only the newest input is kept, older inputs that have not started yet are dropped
+// results are double-buffered
+// 	the worker writes to the back buffer, then waits for it to be picked up
+// 	async_synchronize swaps it to the front once it is finished
+// 	the render thread only ever reads the front buffer
+
+typedef struct async_s async_t;
+
+// compute the result for input
+// 	result is zeroed before compute is called
+// 	long running computations should check async_cancelled between steps
+// 	return false if the result is incomplete (it will be released but not published)
+typedef bool (*async_compute) (async_t* async, const void* input, void* result);
+// free anything a result owns, the result itself is owned by async
+typedef void (*async_release) (void* result);
+
+struct async_s
+{
+	pthread_t thread;
+	pthread_mutex_t mutex;
+	pthread_cond_t condition;
+
+	async_compute compute;
+	async_release release;
+
+	size_t input_size;
+	size_t result_size;
+
+	void* input;  // newest posted input
+	void* job_input;  // copy of the input the worker is computing
+	void* front;  // result read by the render thread
+	void* back;  // result written by the worker
+
+	unsigned long posted;  // number of posted inputs
+	unsigned long started;  // value of posted when the current job started
+
+	bool has_front;
+	bool ready;  // back holds a finished result
+	bool skipped;  // the previous job was cancelled
+	bool quit;
+	bool allocated;  // all buffers above could be allocated
+	bool threaded;  // the worker thread is running, otherwise jobs run in async_post
+};
+
+bool async_initialize (async_t* async, size_t input_size, size_t result_size, async_compute compute, async_release release);
+void async_post (async_t* async, const void* input);
+bool async_synchronize (async_t* async);
+const void* async_result (async_t* async);
+bool async_cancelled (async_t* async);
+void async_cleanup (async_t* async);
+
+#endif
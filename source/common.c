@@ -7,3 +7,27 @@ void nk_break (struct nk_context* context)
 	nk_label (context, "", NK_TEXT_LEFT);
 }
 
+tsSink sink_vector2 (Vector2* points)
+{
+	tsSink sink;
+	sink.data = points;
+	sink.offset = 0;
+	sink.stride = sizeof (Vector2);
+	sink.dim = 2;
+	sink.type = TS_SINK_FLOAT;
+
+	return sink;
+}
+
+tsSink sink_vector3 (Vector3* points)
+{
+	tsSink sink;
+	sink.data = points;
+	sink.offset = 0;
+	sink.stride = sizeof (Vector3);
+	sink.dim = 3;
+	sink.type = TS_SINK_FLOAT;
+
+	return sink;
+}
+
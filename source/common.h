@@ -2,6 +2,7 @@
 #define _common_h_
 
 #include "raylib-nuklear.h"
+#include "tinyspline.h"
 
 #define DRAW_WINDOW_WIDTH 525
 #define DRAW_WINDOW_HEIGHT 525
@@ -9,4 +10,8 @@
 
 void nk_break (struct nk_context* context);
 
+// sinks for evaluating splines straight into raylib vectors
+tsSink sink_vector2 (Vector2* points);
+tsSink sink_vector3 (Vector3* points);
+
 #endif
@@ -27,8 +27,7 @@ static size_t points_count;
 static tsReal* result;
 static size_t result_count;
 
-static tsReal* sample_points;
-static size_t sample_count;
+static Vector2 sample_points[EVAL_SAMPLES];
 
 static nk_bool draw_net;
 static nk_bool autoplay;
@@ -51,7 +50,8 @@ void demo_eval_initialize ()
 	// TODO
 	// 	error handling :D
 	tsStatus status;
-	ts_bspline_sample (&spline, EVAL_SAMPLES, &sample_points, &sample_count, &status);
+	tsSink sink = sink_vector2 (sample_points);
+	ts_bspline_sample_sink (&spline, EVAL_SAMPLES, &sink, &status);
 
 	knot = 0.1f;
 
@@ -92,7 +92,8 @@ void demo_eval_run (struct nk_context* context)
 			ts_bspline_set_control_points (&spline, control_points, NULL);
 			
 			tsStatus status;
-			ts_bspline_sample (&spline, EVAL_SAMPLES, &sample_points, &sample_count, &status);
+			tsSink sink = sink_vector2 (sample_points);
+			ts_bspline_sample_sink (&spline, EVAL_SAMPLES, &sink, &status);
 
 			ts_bspline_eval (&spline, knot, &net, &status);
 
@@ -152,9 +153,9 @@ void demo_eval_draw ()
 		}
 		else
 		{
-			for (int iter = 0; iter < (sample_count - 1); iter++)
+			for (int iter = 0; iter < (EVAL_SAMPLES - 1); iter++)
 			{
-				DrawLine (sample_points[iter * EVAL_DIMENSION], sample_points[(iter * EVAL_DIMENSION) + 1], sample_points[(iter * EVAL_DIMENSION) + 2], sample_points[(iter * EVAL_DIMENSION) + 3], BLACK);
+				DrawLineV (sample_points[iter], sample_points[iter + 1], BLACK);
 			}
 		}
 	}
@@ -217,5 +218,4 @@ void demo_eval_cleanup ()
 	ts_deboornet_free (&net);
 	free (points);
 	free (result);
-	free (sample_points);
 }
@@ -11,26 +11,105 @@
 
 #include "demo_interpolation.h"
 #include "common.h"
+#include "async.h"
+#include "lod.h"
 
 #define FRAMES_POINT_COUNT 11
 #define FRAMES_DIMENSION 3
-#define FRAMES_SAMPLES 100
 #define FRAMES_KNOT_COUNT 1001
+#define FRAMES_SWEEP_STEPS 400
+#define FRAMES_PROFILE_POINTS 8
+// radians the tangent may turn between two rings of the tube
+#define FRAMES_SWEEP_ANGLE 0.1f
+// raylib's default clipping distances
+#define FRAMES_CULL_NEAR 0.01f
+#define FRAMES_CULL_FAR 1000.0f
 
 static Camera3D camera;
 
-static tsReal control_points[FRAMES_POINT_COUNT * FRAMES_DIMENSION];
+typedef struct
+{
+	tsReal control_points[FRAMES_POINT_COUNT * FRAMES_DIMENSION];
+} frames_input_t;
+
+typedef struct
+{
+	lod_curve_t curve;
+	tsFrame frames[FRAMES_KNOT_COUNT];
+	// tube swept along the spline
+	Vector3 tube_vertices[FRAMES_SWEEP_STEPS * FRAMES_PROFILE_POINTS];
+	Vector3 tube_normals[FRAMES_SWEEP_STEPS * FRAMES_PROFILE_POINTS];
+	unsigned int tube_indices[(FRAMES_SWEEP_STEPS - 1) * FRAMES_PROFILE_POINTS * 6];
+	size_t tube_rings;
+} frames_result_t;
 
-static tsBSpline spline;
+static async_t async;
 
-static tsReal* sample_points;
-static size_t sample_count;
+static tsReal control_points[FRAMES_POINT_COUNT * FRAMES_DIMENSION];
 
 static tsReal knot;
-static tsReal knots[FRAMES_KNOT_COUNT];
-static tsFrame frames[FRAMES_KNOT_COUNT];
 
 static nk_bool autoplay;
+static nk_bool draw_tube;
+
+// screen space error of the drawn spline in pixels
+static float pixel_error;
+// lod_select output and the vertices drawn for it
+static unsigned char* segments;
+static size_t segments_capacity;
+static Vector3* vertices;
+static size_t vertices_capacity;
+static size_t spans_drawn;
+static size_t vertices_drawn;
+
+// runs on the worker thread
+bool compute_frames (async_t* async, const void* input_data, void* result_data)
+{
+	const frames_input_t* input = input_data;
+	frames_result_t* result = result_data;
+
+	tsBSpline spline = ts_bspline_init ();
+	tsReal knots[FRAMES_KNOT_COUNT];
+	tsStatus status;
+	bool complete = false;
+
+	TS_TRY (try, status.code, &status)
+		TS_CALL (try, status.code, ts_bspline_new (FRAMES_POINT_COUNT, FRAMES_DIMENSION, 3, TS_CLAMPED, &spline, &status))
+		TS_CALL (try, status.code, ts_bspline_set_control_points (&spline, input->control_points, &status))
+		TS_CALL (try, status.code, lod_curve_initialize (&result->curve, &spline, &status))
+
+		if (!async_cancelled (async))
+		{
+			ts_bspline_uniform_knot_seq (&spline, FRAMES_KNOT_COUNT, knots);
+			TS_CALL (try, status.code, ts_bspline_compute_rmf (&spline, knots, FRAMES_KNOT_COUNT, false, result->frames, &status))
+
+			// counter-clockwise circle so the tube faces outwards
+			tsReal profile[FRAMES_PROFILE_POINTS * 2];
+			for (int iter = 0; iter < FRAMES_PROFILE_POINTS; iter++)
+			{
+				profile[iter * 2] = 1.5f * cosf (iter * 2.0f * PI / FRAMES_PROFILE_POINTS);
+				profile[iter * 2 + 1] = 1.5f * sinf (iter * 2.0f * PI / FRAMES_PROFILE_POINTS);
+			}
+			tsSink tube_vertices = sink_vector3 (result->tube_vertices);
+			tsSink tube_normals = sink_vector3 (result->tube_normals);
+			TS_CALL (try, status.code, ts_bspline_sweep (&spline, profile, FRAMES_PROFILE_POINTS, true, FRAMES_SWEEP_STEPS, FRAMES_SWEEP_ANGLE, &tube_vertices, &tube_normals, result->tube_indices, &result->tube_rings, &status))
+			complete = true;
+		}
+	TS_CATCH (status.code)
+		printf ("compute_frames: %s\n", status.message);
+	TS_FINALLY
+		ts_bspline_free (&spline);
+	TS_END_TRY
+
+	return complete;
+}
+
+void release_frames (void* result_data)
+{
+	frames_result_t* result = result_data;
+
+	lod_curve_cleanup (&result->curve);
+}
 
 void demo_frames_initialize ()
 {
@@ -46,11 +125,15 @@ void demo_frames_initialize ()
 	control_points[27] = 3.0; control_points[28] = 23.0; control_points[29] = 1.0; // P10
 	control_points[30] = 8.0; control_points[31] = 30.0; control_points[32] = 0; // P11
 
-	ts_bspline_new (FRAMES_POINT_COUNT, FRAMES_DIMENSION, 3, TS_CLAMPED, &spline, NULL);
-	ts_bspline_set_control_points (&spline, control_points, NULL);
-
-	tsStatus status;
-	ts_bspline_sample (&spline, FRAMES_SAMPLES, &sample_points, &sample_count, &status);
+	// the spline, its bezier spans and its frames are computed in the background
+	frames_input_t input;
+	memcpy (input.control_points, control_points, sizeof (control_points));
+	if (!async_initialize (&async, sizeof (frames_input_t), sizeof (frames_result_t), compute_frames, release_frames))
+	{
+		// async_post falls back to computing on the render thread
+		printf ("demo_frames: no worker thread, computing synchronously\n");
+	}
+	async_post (&async, &input);
 
 	camera.position = (Vector3) {-24.839f, 18.0f, -28.49f};
 	camera.target = (Vector3) {-21.318f, 17.182f, -22.239f};
@@ -62,10 +145,21 @@ void demo_frames_initialize ()
 
 	knot = 0.0f;
 
-	ts_bspline_uniform_knot_seq (&spline, FRAMES_KNOT_COUNT, knots);
-	ts_bspline_compute_rmf (&spline, knots, FRAMES_KNOT_COUNT, false, frames, &status);
-
 	autoplay = false;
+	draw_tube = false;
+
+	pixel_error = 0.5f;
+	segments = NULL;
+	segments_capacity = 0;
+	vertices = NULL;
+	vertices_capacity = 0;
+	spans_drawn = 0;
+	vertices_drawn = 0;
+}
+
+void demo_frames_synchronize ()
+{
+	async_synchronize (&async);
 }
 
 void demo_frames_run (struct nk_context* context)
@@ -78,9 +172,28 @@ void demo_frames_run (struct nk_context* context)
 		nk_break (context);
 
 		nk_checkbox_label (context, "Autoplay", &autoplay);
+		nk_checkbox_label (context, "Tube", &draw_tube);
+		nk_break (context);
+
+		nk_slider_float (context, 0.1f, &pixel_error, 4.0f, 0.1f);
+		nk_labelf (context, NK_TEXT_CENTERED, "Pixel error: %.1f", pixel_error);
+		nk_labelf (context, NK_TEXT_LEFT, "Spans drawn: %i", (int) spans_drawn);
+		nk_labelf (context, NK_TEXT_LEFT, "Vertices: %i", (int) vertices_drawn);
+		nk_label (context, "Mouse wheel to zoom", NK_TEXT_LEFT);
 	}
 	nk_end (context);
 
+	// dolly the camera so spans can be seen getting refined and culled
+	Vector2 mouse_position = GetMousePosition ();
+	float wheel = GetMouseWheelMove ();
+	if (wheel != 0.0f && mouse_position.x < DRAW_WINDOW_WIDTH && mouse_position.y > TAB_OFFSET)
+	{
+		Vector3 forward = Vector3Normalize (Vector3Subtract (camera.target, camera.position));
+		Vector3 step = Vector3Scale (forward, wheel * 2.0f);
+		camera.position = Vector3Add (camera.position, step);
+		camera.target = Vector3Add (camera.target, step);
+	}
+
 	if (autoplay)
 	{
 		// if we are running at our target fps of 60
@@ -99,14 +212,79 @@ void demo_frames_draw ()
 	// 	the constrast looks better
 	ClearBackground (BLACK);
 
+	// nothing to draw until the worker has finished
+	const frames_result_t* result = async_result (&async);
+	if (!result)
+	{
+		return;
+	}
+
+	// only tessellate what is on screen, as finely as the pixel error allows
+	const lod_curve_t* curve = &result->curve;
+	if (segments_capacity < curve->span_count)
+	{
+		// skip this frame if there is no memory, the old buffer stays valid
+		unsigned char* grown = realloc (segments, curve->span_count);
+		if (!grown)
+		{
+			return;
+		}
+		segments = grown;
+		segments_capacity = curve->span_count;
+	}
+
+	lod_view_t view;
+	lod_view_initialize (&view, camera, DRAW_WINDOW_WIDTH, DRAW_WINDOW_HEIGHT, FRAMES_CULL_NEAR, FRAMES_CULL_FAR, pixel_error);
+	size_t segment_count = lod_select (curve, &view, segments);
+
+	if (vertices_capacity < segment_count * 2)
+	{
+		Vector3* grown = realloc (vertices, segment_count * 2 * sizeof (Vector3));
+		if (!grown)
+		{
+			return;
+		}
+		vertices = grown;
+		vertices_capacity = segment_count * 2;
+	}
+	vertices_drawn = lod_emit (curve, segments, vertices);
+
+	spans_drawn = 0;
+	for (size_t iter = 0; iter < curve->span_count; iter++)
+	{
+		spans_drawn += segments[iter] > 0;
+	}
+
 	BeginMode3D (camera);
 	{
-		for (int iter = 0; iter < (sample_count - 1); iter++)
+		for (size_t iter = 0; iter < vertices_drawn; iter += 2)
 		{
-			DrawLine3D ((Vector3) {sample_points[iter * FRAMES_DIMENSION], sample_points[(iter * FRAMES_DIMENSION) + 1], sample_points[(iter * FRAMES_DIMENSION) + 2]}, (Vector3) {sample_points[(iter * FRAMES_DIMENSION) + 3], sample_points[(iter * FRAMES_DIMENSION) + 4], sample_points[(iter * FRAMES_DIMENSION) + 5]}, WHITE);
+			DrawLine3D (vertices[iter], vertices[iter + 1], WHITE);
 		}
 
-		tsFrame* frame = &frames[(int) (knot * 1000)];
+		if (draw_tube && result->tube_rings > 1)
+		{
+			Vector3 light = Vector3Normalize ((Vector3) {-1.0f, 1.0f, -1.0f});
+			size_t index_count = (result->tube_rings - 1) * FRAMES_PROFILE_POINTS * 6;
+
+			for (size_t iter = 0; iter < index_count; iter += 3)
+			{
+				Vector3 corners[3];
+				float brightness = 0.0f;
+
+				for (int corner = 0; corner < 3; corner++)
+				{
+					unsigned int index = result->tube_indices[iter + corner];
+					corners[corner] = result->tube_vertices[index];
+					brightness += Vector3DotProduct (result->tube_normals[index], light) / 3.0f;
+				}
+
+				unsigned char shade = 60 + 160 * (brightness > 0.0f ? brightness : 0.0f);
+				DrawTriangle3D (corners[0], corners[1], corners[2], (Color) {shade, shade, shade, 255});
+			}
+		}
+
+		const tsFrame* frame = &result->frames[(int) (knot * 1000)];
 		Vector3 position = (Vector3) {frame->position[0], frame->position[1], frame->position[2]};
 		Vector3 tangent = (Vector3) {frame->tangent[0], frame->tangent[1], frame->tangent[2]};
 		Vector3 binormal = (Vector3) {frame->binormal[0], frame->binormal[1], frame->binormal[2]};
@@ -121,7 +299,9 @@ void demo_frames_draw ()
 
 void demo_frames_cleanup ()
 {
-	free (sample_points);
-	ts_bspline_free (&spline);
+	async_cleanup (&async);
+
+	free (segments);
+	free (vertices);
 }
 
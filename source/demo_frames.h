@@ -4,6 +4,7 @@
 #include "raylib-nuklear.h"
 
 void demo_frames_initialize ();
+void demo_frames_synchronize ();
 void demo_frames_run (struct nk_context* context);
 void demo_frames_draw ();
 void demo_frames_cleanup ();
@@ -9,6 +9,7 @@
 
 #include "demo_interpolation.h"
 #include "common.h"
+#include "async.h"
 
 #define INTERPOLATION_POINT_COUNT 7
 #define INTERPOLATION_DIMENSION 2
@@ -20,11 +21,23 @@ enum
 	TYPE_CATMULL_ROM
 };
 
-static tsBSpline spline_cubic;
-static tsBSpline spline_catmull;
+typedef struct
+{
+	tsReal points[INTERPOLATION_POINT_COUNT * INTERPOLATION_DIMENSION];
+	size_t point_count;
+	tsReal alpha;
+	tsReal epsilon;
+} interpolation_input_t;
+
+typedef struct
+{
+	Vector2 samples[2][INTERPOLATION_SAMPLES];  // indexed by TYPE_*
+	bool sampled[2];
+} interpolation_result_t;
+
+static async_t async;
 
 static cvector (tsReal) points;
-static cvector (tsReal) points_draw;
 
 static tsReal demo_alpha;
 static int selected;
@@ -47,37 +60,65 @@ void reset ()
 	demo_alpha = 0.5;
 }
 
-void interpolate_splines (cvector (tsReal) points, int dimension, tsReal alpha, tsReal epsilon)
+void sample_interpolated_spline (tsBSpline* spline, interpolation_result_t* result, int type)
 {
-	if (dimension == 0)
+	tsStatus status;
+	tsSink sink = sink_vector2 (result->samples[type]);
+
+	result->sampled[type] = ts_bspline_sample_sink (spline, INTERPOLATION_SAMPLES, &sink, &status) == TS_SUCCESS;
+	ts_bspline_free (spline);
+}
+
+// runs on the worker thread
+bool interpolate_splines (async_t* async, const void* input_data, void* result_data)
+{
+	const interpolation_input_t* input = input_data;
+	interpolation_result_t* result = result_data;
+
+	tsStatus status;
+	tsBSpline spline = ts_bspline_init ();
+
+	// a failed interpolation leaves spline without control points, so there is nothing to sample
+	// 	returning false keeps the previous result on the front
+	if (ts_bspline_interpolate_cubic_natural (input->points, input->point_count, INTERPOLATION_DIMENSION, &spline, &status) != TS_SUCCESS)
 	{
-		printf ("interpolate_splines: dimension 0 unsupported\n");
-		return;
+		return false;
 	}
-	if (cvector_size (points) % dimension != 0)
+	sample_interpolated_spline (&spline, result, TYPE_CUBIC_NATURAL);
+
+	// the points changed while we were working on the cubic spline
+	// 	dont bother with the catmull-rom spline
+	if (async_cancelled (async))
 	{
-		printf ("interpolate_splines: number of points not a multiple of dimension\n");
-		return;
+		return false;
 	}
 
-	tsStatus status;
+	if (ts_bspline_interpolate_catmull_rom (input->points, input->point_count, INTERPOLATION_DIMENSION, input->alpha, NULL, NULL, input->epsilon, &spline, &status) != TS_SUCCESS)
+	{
+		return false;
+	}
+	sample_interpolated_spline (&spline, result, TYPE_CATMULL_ROM);
+
+	return true;
+}
 
-	ts_bspline_free (&spline_cubic);
-	spline_cubic = ts_bspline_init ();
-	ts_bspline_interpolate_cubic_natural (points, cvector_size (points) / dimension, dimension, &spline_cubic, &status);
+// hand the current points off to the worker
+void post_interpolation (tsReal epsilon)
+{
+	interpolation_input_t input;
 
-	ts_bspline_free (&spline_catmull);
-	spline_catmull = ts_bspline_init ();
-	ts_bspline_interpolate_catmull_rom (points, cvector_size (points) / dimension, dimension, alpha, NULL, NULL, epsilon, &spline_catmull, &status);
+	memcpy (input.points, points, cvector_size (points) * sizeof (tsReal));
+	input.point_count = cvector_size (points) / INTERPOLATION_DIMENSION;
+	input.alpha = demo_alpha;
+	input.epsilon = epsilon;
 
+	async_post (&async, &input);
 }
 
 void demo_interpolation_initialize ()
 {
 	points = NULL;
 	cvector_init (points, INTERPOLATION_POINT_COUNT * INTERPOLATION_DIMENSION, NULL);
-	points_draw = NULL;
-	cvector_init (points_draw, INTERPOLATION_POINT_COUNT * INTERPOLATION_DIMENSION, NULL);
 
 	reset ();
 
@@ -85,16 +126,17 @@ void demo_interpolation_initialize ()
 	draw_catmull = true;
 	selected = -1;
 
-	spline_cubic = ts_bspline_init ();
-	spline_catmull = ts_bspline_init ();
+	if (!async_initialize (&async, sizeof (interpolation_input_t), sizeof (interpolation_result_t), interpolate_splines, NULL))
+	{
+		// async_post falls back to computing on the render thread
+		printf ("demo_interpolation: no worker thread, computing synchronously\n");
+	}
+	post_interpolation (0.1f);
+}
 
-	// TODO/FIXME
-	// 	put these cvector ops in interpolate_splines
-	// 		when they are there we get a segfault though
-	// 		? why ?
-	cvector_clear (points_draw);
-	cvector_copy (points, points_draw);
-	interpolate_splines (points_draw, INTERPOLATION_DIMENSION, demo_alpha, 0.1f);
+void demo_interpolation_synchronize ()
+{
+	async_synchronize (&async);
 }
 
 void demo_interpolation_run (struct nk_context* context)
@@ -154,9 +196,7 @@ void demo_interpolation_run (struct nk_context* context)
 			points[drag_index] = new_x;
 			points[drag_index + 1] = new_y;
 
-			cvector_clear (points_draw);
-			cvector_copy (points, points_draw);
-			interpolate_splines (points_draw, INTERPOLATION_DIMENSION, demo_alpha, TS_POINT_EPSILON);
+			post_interpolation (TS_POINT_EPSILON);
 		}
 	}
 
@@ -171,9 +211,7 @@ void demo_interpolation_run (struct nk_context* context)
 
 		if (nk_slider_float (context, 0.0f, &demo_alpha, 1.0f, 0.01f))
 		{
-			cvector_clear (points_draw);
-			cvector_copy (points, points_draw);
-			interpolate_splines (points_draw, INTERPOLATION_DIMENSION, demo_alpha, TS_POINT_EPSILON);
+			post_interpolation (TS_POINT_EPSILON);
 		}
 		nk_labelf (context, NK_TEXT_CENTERED, "alpha: %.2f", demo_alpha);
 		nk_break (context);
@@ -183,9 +221,7 @@ void demo_interpolation_run (struct nk_context* context)
 		{
 			reset ();
 
-			cvector_clear (points_draw);
-			cvector_copy (points, points_draw);
-			interpolate_splines (points_draw, INTERPOLATION_DIMENSION, demo_alpha, TS_POINT_EPSILON);
+			post_interpolation (TS_POINT_EPSILON);
 		}
 	}
 	nk_end (context);
@@ -193,17 +229,14 @@ void demo_interpolation_run (struct nk_context* context)
 
 void draw_interpolated_spline (int type)
 {
-	tsBSpline* spline_draw;
 	Color color;
 
 	if (type == TYPE_CUBIC_NATURAL)
 	{
-		spline_draw = &spline_cubic;
 		color = GREEN;
 	}
 	else if (type == TYPE_CATMULL_ROM)
 	{
-		spline_draw = &spline_catmull;
 		color = BLUE;
 	}
 	else
@@ -211,18 +244,19 @@ void draw_interpolated_spline (int type)
 		return;
 	}
 
-	tsReal* sample_points; 
-	size_t sample_count;
-	tsStatus status;
+	// nothing to draw until the worker has finished its first result
+	const interpolation_result_t* result = async_result (&async);
+	if (!result || !result->sampled[type])
+	{
+		return;
+	}
 
-	ts_bspline_sample (spline_draw, INTERPOLATION_SAMPLES, &sample_points, &sample_count, &status);
+	const Vector2* sample_points = result->samples[type];
 
-	for (int iter = 0; iter < (sample_count - 1); iter ++)
+	for (int iter = 0; iter < (INTERPOLATION_SAMPLES - 1); iter ++)
 	{
-		DrawLineEx ((Vector2) {sample_points[iter * INTERPOLATION_DIMENSION], sample_points[(iter * INTERPOLATION_DIMENSION) + 1]}, (Vector2) {sample_points[(iter * INTERPOLATION_DIMENSION) + 2], sample_points[(iter * INTERPOLATION_DIMENSION) + 3]}, 1.0f, color);
+		DrawLineEx (sample_points[iter], sample_points[iter + 1], 1.0f, color);
 	}
-
-	free (sample_points);
 }
 
 void demo_interpolation_draw ()
@@ -246,10 +280,8 @@ void demo_interpolation_draw ()
 
 void demo_interpolation_cleanup ()
 {
-	ts_bspline_free (&spline_cubic);
-	ts_bspline_free (&spline_catmull);
+	async_cleanup (&async);
 
 	cvector_free (points);
-	cvector_free (points_draw);
 }
 
@@ -4,6 +4,7 @@
 #include "raylib-nuklear.h"
 
 void demo_interpolation_initialize ();
+void demo_interpolation_synchronize ();
 void demo_interpolation_run (struct nk_context* context);
 void demo_interpolation_draw ();
 void demo_interpolation_cleanup ();
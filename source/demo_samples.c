@@ -9,6 +9,7 @@
 #define SAMPLES_POINT_COUNT 7
 #define SAMPLES_DIMENSION 2
 #define SAMPLES_SPLINE_DEGREE 3
+#define SAMPLES_MAX 100
 
 static tsReal control_points[SAMPLES_POINT_COUNT * SAMPLES_DIMENSION];
 
@@ -17,9 +18,9 @@ static tsBSpline spline_opened;
 
 static int samples;
 static size_t sample_count;
-static tsReal* points_clamped;
-static tsReal* points_opened;
-static tsReal* points;  // points at either points_clamped or points_opened
+static Vector2 points_clamped[SAMPLES_MAX];
+static Vector2 points_opened[SAMPLES_MAX];
+static Vector2* points;  // points at either points_clamped or points_opened
 static tsStatus status;
 
 static nk_bool show_sampled_points;
@@ -27,6 +28,17 @@ static nk_bool show_control_points;
 static nk_bool clamped;
 static nk_bool opened;
 
+void sample_splines ()
+{
+	// 0 samples falls back to the maximum, like ts_bspline_sample does
+	sample_count = samples > 0 ? samples : SAMPLES_MAX;
+
+	tsSink sink = sink_vector2 (points_clamped);
+	ts_bspline_sample_sink (&spline_clamped, sample_count, &sink, &status);
+	sink = sink_vector2 (points_opened);
+	ts_bspline_sample_sink (&spline_opened, sample_count, &sink, &status);
+}
+
 void demo_samples_initialize ()
 {
 	control_points[0]  = 50;  control_points[1]  = 50;  // P1
@@ -50,8 +62,7 @@ void demo_samples_initialize ()
 	ts_bspline_set_control_points (&spline_clamped, control_points, NULL);
 	ts_bspline_set_control_points (&spline_opened, control_points, NULL);
 
-	ts_bspline_sample (&spline_clamped, samples, &points_clamped, &sample_count, &status);
-	ts_bspline_sample (&spline_opened, samples, &points_opened, &sample_count, &status);
+	sample_splines ();
 
 	points = points_clamped;
 }
@@ -63,11 +74,7 @@ void demo_samples_run (struct nk_context* context)
 		nk_layout_row_dynamic (context, 20, 1);
 		if (nk_slider_int (context, 0, &samples, 100, 1))
 		{
-			free (points_clamped);
-			free (points_opened);
-
-			ts_bspline_sample (&spline_clamped, samples, &points_clamped, &sample_count, &status);
-			ts_bspline_sample (&spline_opened, samples, &points_opened, &sample_count, &status);
+			sample_splines ();
 		}
 		nk_labelf (context, NK_TEXT_CENTERED, "Samples: %i", samples);
 		nk_break (context);
@@ -117,14 +124,14 @@ void demo_samples_draw ()
 
 	for (int iter = 0; iter < sample_count - 1; iter++)
 	{
-		DrawLine (points[iter * SAMPLES_DIMENSION], points[(iter * SAMPLES_DIMENSION) + 1], points[(iter * SAMPLES_DIMENSION) + 2], points[(iter * SAMPLES_DIMENSION) + 3], BLACK);
+		DrawLineV (points[iter], points[iter + 1], BLACK);
 	}
 
 	if (show_sampled_points)
 	{
 		for (int iter = 0; iter < sample_count; iter++)
 		{
-			DrawRectangle (points[iter * SAMPLES_DIMENSION] - 2, points[(iter * SAMPLES_DIMENSION) + 1] - 2, 4, 4, BLUE);
+			DrawRectangle (points[iter].x - 2, points[iter].y - 2, 4, 4, BLUE);
 		}
 	}
 }
@@ -133,7 +140,5 @@ void demo_samples_cleanup ()
 {
 	ts_bspline_free (&spline_clamped);
 	ts_bspline_free (&spline_opened);
-	free (points_clamped);
-	free (points_opened);
 }
 
@@ -0,0 +1,322 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+
+#include "tinyspline.h"
+#include "raylib.h"
+#include "raylib-nuklear.h"
+
+#include "demo_stress.h"
+#include "common.h"
+#include "async.h"
+
+#define STRESS_DIMENSION 2
+#define STRESS_MAX_DEGREE 7
+#define STRESS_MAX_CURVES 1000
+// cubic natural interpolation turns n points into 4 (n - 1) control points
+// 	so more samples than this would exceed TS_MAX_NUM_KNOTS
+#define STRESS_MAX_SAMPLES 2000
+// drawing every curve at 10^6 control points would make rendering the bottleneck
+#define STRESS_MAX_DRAWN_CURVES 256
+
+enum
+{
+	TIMING_GENERATE,
+	TIMING_EVAL,
+	TIMING_SAMPLE,
+	TIMING_RMF,
+	TIMING_INTERPOLATE,
+	TIMING_COUNT
+};
+
+static const char* timing_names[TIMING_COUNT] =
+{
+	"Generate",
+	"Eval",
+	"Sample",
+	"RMF",
+	"Interpolate"
+};
+
+typedef struct
+{
+	int degree;
+	int curve_count;
+	int sample_count;
+	float control_point_exponent;  // total control points = 10^exponent
+} stress_input_t;
+
+typedef struct
+{
+	stress_input_t input;
+	// the values actually used
+	// 	control points per curve are limited by TS_MAX_NUM_KNOTS
+	size_t curve_count;
+	size_t control_point_count;  // per curve
+	size_t sample_count;  // per curve
+	// samples of the drawn curves, sample_count points per curve
+	Vector2* samples;
+	size_t drawn_curve_count;
+	double timings[TIMING_COUNT];  // milliseconds, summed over all curves
+	tsStatus status;  // shown instead of the result if a call failed
+} stress_result_t;
+
+static async_t async;
+static stress_input_t settings;
+
+// GetTime is not meant to be called off the main thread
+double stress_time ()
+{
+	struct timespec now;
+	clock_gettime (CLOCK_MONOTONIC, &now);
+
+	return now.tv_sec * 1000.0 + now.tv_nsec / 1000000.0;
+}
+
+// fills control_points with a lissajous-like curve that stays inside the draw window
+// 	every curve gets its own frequencies so large counts dont just overlap
+void stress_generate (tsReal* control_points, size_t count, size_t curve)
+{
+	float frequency_x = 1.0f + (curve % 7);
+	float frequency_y = 2.0f + (curve % 5);
+	float phase = curve * 0.37f;
+	float radius = 40.0f + (curve % 23) * 9.0f;
+
+	for (size_t iter = 0; iter < count; iter++)
+	{
+		float t = (float) iter / (count - 1) * 2.0f * PI;
+		// a little high frequency wobble so the control polygon is not trivially smooth
+		float wobble = 1.0f + 0.05f * sinf (t * count * 0.25f);
+
+		control_points[iter * STRESS_DIMENSION] = DRAW_WINDOW_WIDTH / 2.0f + radius * wobble * sinf (frequency_x * t + phase);
+		control_points[iter * STRESS_DIMENSION + 1] = DRAW_WINDOW_HEIGHT / 2.0f + radius * wobble * cosf (frequency_y * t);
+	}
+}
+
+// runs on the worker thread
+bool stress_compute (async_t* async, const void* input_data, void* result_data)
+{
+	const stress_input_t* input = input_data;
+	stress_result_t* result = result_data;
+
+	size_t order = input->degree + 1;
+	size_t total = (size_t) (pow (10.0, input->control_point_exponent) + 0.5);
+	size_t curve_count = input->curve_count;
+	size_t per_curve_limit = TS_MAX_NUM_KNOTS - order;
+
+	// use more curves if a single curve can not hold its share of control points
+	if ((total + curve_count - 1) / curve_count > per_curve_limit)
+	{
+		curve_count = (total + per_curve_limit - 1) / per_curve_limit;
+	}
+
+	result->input = *input;
+	result->curve_count = curve_count;
+	result->control_point_count = total / curve_count;
+	if (result->control_point_count < order)
+	{
+		result->control_point_count = order;
+	}
+	result->sample_count = input->sample_count;
+	result->drawn_curve_count = curve_count < STRESS_MAX_DRAWN_CURVES ? curve_count : STRESS_MAX_DRAWN_CURVES;
+	result->samples = malloc (result->drawn_curve_count * result->sample_count * sizeof (Vector2));
+
+	tsReal* control_points = malloc (result->control_point_count * STRESS_DIMENSION * sizeof (tsReal));
+	tsReal* knots = malloc (result->sample_count * sizeof (tsReal));
+	tsFrame* frames = malloc (result->sample_count * sizeof (tsFrame));
+	tsReal* samples = malloc (result->sample_count * STRESS_DIMENSION * sizeof (tsReal));
+	tsSink sink = {samples, 0, 0, STRESS_DIMENSION, TS_SINK_REAL};
+
+	tsBSpline spline = ts_bspline_init ();
+	tsBSpline interpolated = ts_bspline_init ();
+	tsDeBoorNet net = ts_deboornet_init ();
+	tsStatus status;
+	bool complete = false;
+	bool cancelled = false;
+
+	TS_TRY (try, status.code, &status)
+		if (!result->samples || !control_points || !knots || !frames || !samples)
+		{
+			TS_THROW_0 (try, status.code, &status, TS_MALLOC, "out of memory")
+		}
+
+		for (size_t curve = 0; curve < curve_count; curve++)
+		{
+			// settings changed, this result will never be shown
+			if (async_cancelled (async))
+			{
+				cancelled = true;
+				break;
+			}
+
+			double start = stress_time ();
+			stress_generate (control_points, result->control_point_count, curve);
+			ts_bspline_free (&spline);
+			TS_CALL (try, status.code, ts_bspline_new (result->control_point_count, STRESS_DIMENSION, input->degree, TS_CLAMPED, &spline, &status))
+			TS_CALL (try, status.code, ts_bspline_set_control_points (&spline, control_points, &status))
+			ts_bspline_uniform_knot_seq (&spline, result->sample_count, knots);
+			double end = stress_time ();
+			result->timings[TIMING_GENERATE] += end - start;
+
+			start = end;
+			for (size_t iter = 0; iter < result->sample_count; iter++)
+			{
+				ts_deboornet_free (&net);
+				TS_CALL (try, status.code, ts_bspline_eval (&spline, knots[iter], &net, &status))
+			}
+			end = stress_time ();
+			result->timings[TIMING_EVAL] += end - start;
+
+			start = end;
+			TS_CALL (try, status.code, ts_bspline_sample_sink (&spline, result->sample_count, &sink, &status))
+			end = stress_time ();
+			result->timings[TIMING_SAMPLE] += end - start;
+
+			start = end;
+			TS_CALL (try, status.code, ts_bspline_compute_rmf (&spline, knots, result->sample_count, false, frames, &status))
+			end = stress_time ();
+			result->timings[TIMING_RMF] += end - start;
+
+			start = end;
+			ts_bspline_free (&interpolated);
+			TS_CALL (try, status.code, ts_bspline_interpolate_cubic_natural (samples, result->sample_count, STRESS_DIMENSION, &interpolated, &status))
+			end = stress_time ();
+			result->timings[TIMING_INTERPOLATE] += end - start;
+
+			// not timed, this is only for drawing
+			if (curve < result->drawn_curve_count)
+			{
+				tsSink draw_sink = sink_vector2 (result->samples + curve * result->sample_count);
+				TS_CALL (try, status.code, ts_bspline_sample_sink (&spline, result->sample_count, &draw_sink, &status))
+			}
+		}
+
+		complete = !cancelled;
+	TS_CATCH (status.code)
+		// show the error instead of a result
+		result->status = status;
+		result->drawn_curve_count = 0;
+		complete = true;
+	TS_FINALLY
+		ts_bspline_free (&spline);
+		ts_bspline_free (&interpolated);
+		ts_deboornet_free (&net);
+		free (control_points);
+		free (knots);
+		free (frames);
+		free (samples);
+	TS_END_TRY
+
+	return complete;
+}
+
+void stress_release (void* result_data)
+{
+	stress_result_t* result = result_data;
+
+	free (result->samples);
+}
+
+void demo_stress_initialize ()
+{
+	settings.degree = 3;
+	settings.curve_count = 10;
+	settings.sample_count = 200;
+	settings.control_point_exponent = 3.0f;
+
+	if (!async_initialize (&async, sizeof (stress_input_t), sizeof (stress_result_t), stress_compute, stress_release))
+	{
+		// async_post falls back to computing on the render thread
+		printf ("demo_stress: no worker thread, computing synchronously\n");
+	}
+	async_post (&async, &settings);
+}
+
+void demo_stress_synchronize ()
+{
+	async_synchronize (&async);
+}
+
+void demo_stress_run (struct nk_context* context)
+{
+	bool changed = false;
+	const stress_result_t* result = async_result (&async);
+
+	if (nk_begin (context, "stress controls", nk_rect (525, TAB_OFFSET, 340, 525), NK_WINDOW_NO_SCROLLBAR))
+	{
+		nk_layout_row_dynamic (context, 20, 1);
+
+		changed |= nk_slider_int (context, 1, &settings.degree, STRESS_MAX_DEGREE, 1);
+		nk_labelf (context, NK_TEXT_CENTERED, "Degree: %i", settings.degree);
+		changed |= nk_slider_float (context, 3.0f, &settings.control_point_exponent, 6.0f, 0.25f);
+		nk_labelf (context, NK_TEXT_CENTERED, "Control points: %i", (int) (pow (10.0, settings.control_point_exponent) + 0.5));
+		changed |= nk_slider_int (context, 1, &settings.curve_count, STRESS_MAX_CURVES, 1);
+		nk_labelf (context, NK_TEXT_CENTERED, "Curves: %i", settings.curve_count);
+		changed |= nk_slider_int (context, 10, &settings.sample_count, STRESS_MAX_SAMPLES, 10);
+		nk_labelf (context, NK_TEXT_CENTERED, "Samples per curve: %i", settings.sample_count);
+		nk_break (context);
+
+		if (!result)
+		{
+			nk_label (context, "Computing...", NK_TEXT_LEFT);
+		}
+		else if (result->status.code != TS_SUCCESS)
+		{
+			nk_label_wrap (context, result->status.message);
+		}
+		else
+		{
+			nk_labelf (context, NK_TEXT_LEFT, "%i curves x %i control points", (int) result->curve_count, (int) result->control_point_count);
+			nk_layout_row_dynamic (context, 20, 3);
+			nk_label (context, "", NK_TEXT_LEFT);
+			nk_label (context, "total ms", NK_TEXT_RIGHT);
+			nk_label (context, "us / point", NK_TEXT_RIGHT);
+			for (int iter = 0; iter < TIMING_COUNT; iter++)
+			{
+				nk_label (context, timing_names[iter], NK_TEXT_LEFT);
+				nk_labelf (context, NK_TEXT_RIGHT, "%.2f", result->timings[iter]);
+				nk_labelf (context, NK_TEXT_RIGHT, "%.3f", result->timings[iter] * 1000.0 / (result->curve_count * result->sample_count));
+			}
+			nk_layout_row_dynamic (context, 20, 1);
+		}
+
+		if (result && (result->input.degree != settings.degree
+				|| result->input.curve_count != settings.curve_count
+				|| result->input.sample_count != settings.sample_count
+				|| result->input.control_point_exponent != settings.control_point_exponent))
+		{
+			nk_label (context, "Updating...", NK_TEXT_LEFT);
+		}
+	}
+	nk_end (context);
+
+	if (changed)
+	{
+		async_post (&async, &settings);
+	}
+}
+
+void demo_stress_draw ()
+{
+	ClearBackground (BLACK);
+
+	const stress_result_t* result = async_result (&async);
+	if (!result)
+	{
+		return;
+	}
+
+	for (size_t curve = 0; curve < result->drawn_curve_count; curve++)
+	{
+		Color color = ColorFromHSV ((curve * 137) % 360, 0.6f, 0.9f);
+		DrawLineStrip (result->samples + curve * result->sample_count, result->sample_count, color);
+	}
+}
+
+void demo_stress_cleanup ()
+{
+	async_cleanup (&async);
+}
@@ -0,0 +1,12 @@
+#ifndef _demo_stress_h_
+#define _demo_stress_h_
+
+#include "raylib-nuklear.h"
+
+void demo_stress_initialize ();
+void demo_stress_synchronize ();
+void demo_stress_run (struct nk_context* context);
+void demo_stress_draw ();
+void demo_stress_cleanup ();
+
+#endif
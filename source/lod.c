@@ -0,0 +1,232 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lod.h"
+#include "raymath.h"
+
+// control points of 2d splines are put on the z = 0 plane
+Vector3 lod_point (const tsReal* point, size_t dimension)
+{
+	return (Vector3) {point[0], dimension > 1 ? point[1] : 0.0f, dimension > 2 ? point[2] : 0.0f};
+}
+
+tsError lod_curve_initialize (lod_curve_t* curve, const tsBSpline* spline, tsStatus* status)
+{
+	tsReal* control_points = NULL;
+
+	memset (curve, 0, sizeof (lod_curve_t));
+	curve->beziers = ts_bspline_init ();
+
+	// splitting into beziers keeps the order, so reject unsupported splines before doing any work
+	if (ts_bspline_order (spline) > LOD_MAX_ORDER)
+	{
+		TS_RETURN_2 (status, LOD_ORDER_UNSUPPORTED, "order (%lu) > LOD_MAX_ORDER (%d)", (unsigned long) ts_bspline_order (spline), LOD_MAX_ORDER)
+	}
+
+	tsError error;
+	TS_TRY (try, error, status)
+		TS_CALL (try, error, ts_bspline_to_beziers (spline, &curve->beziers, status))
+		TS_CALL (try, error, ts_bspline_control_points (&curve->beziers, &control_points, status))
+
+		curve->order = ts_bspline_order (&curve->beziers);
+		curve->dimension = ts_bspline_dimension (&curve->beziers);
+		curve->span_count = ts_bspline_num_control_points (&curve->beziers) / curve->order;
+		curve->spans = malloc (curve->span_count * sizeof (lod_span_t));
+		if (!curve->spans)
+		{
+			TS_THROW_0 (try, error, status, TS_MALLOC, "out of memory")
+		}
+
+		size_t degree = curve->order - 1;
+		for (size_t span = 0; span < curve->span_count; span++)
+		{
+			const tsReal* points = control_points + span * curve->order * curve->dimension;
+			lod_span_t* bounds = &curve->spans[span];
+
+			// sphere around the bounding box of the control points
+			Vector3 minimum = lod_point (points, curve->dimension);
+			Vector3 maximum = minimum;
+			for (size_t iter = 1; iter < curve->order; iter++)
+			{
+				Vector3 point = lod_point (points + iter * curve->dimension, curve->dimension);
+				minimum = Vector3Min (minimum, point);
+				maximum = Vector3Max (maximum, point);
+			}
+			bounds->center = Vector3Scale (Vector3Add (minimum, maximum), 0.5f);
+			bounds->radius = 0.0f;
+			for (size_t iter = 0; iter < curve->order; iter++)
+			{
+				Vector3 offset = Vector3Subtract (lod_point (points + iter * curve->dimension, curve->dimension), bounds->center);
+				bounds->radius = fmaxf (bounds->radius, Vector3Length (offset));
+			}
+
+			// a bezier curve of degree p split into n uniform segments
+			// 	deviates from its polyline by at most p (p - 1) / 8 * max |P[i] - 2 P[i+1] + P[i+2]| / n^2
+			float second_difference = 0.0f;
+			for (size_t iter = 0; iter + 2 < curve->order; iter++)
+			{
+				Vector3 a = lod_point (points + iter * curve->dimension, curve->dimension);
+				Vector3 b = lod_point (points + (iter + 1) * curve->dimension, curve->dimension);
+				Vector3 c = lod_point (points + (iter + 2) * curve->dimension, curve->dimension);
+				Vector3 difference = Vector3Add (Vector3Subtract (a, Vector3Scale (b, 2.0f)), c);
+				second_difference = fmaxf (second_difference, Vector3Length (difference));
+			}
+			bounds->scale = degree > 1 ? sqrtf (degree * (degree - 1) / 8.0f * second_difference) : 0.0f;
+		}
+	TS_CATCH (error)
+		lod_curve_cleanup (curve);
+	TS_FINALLY
+		free (control_points);
+	TS_END_TRY_RETURN (error)
+}
+
+void lod_curve_cleanup (lod_curve_t* curve)
+{
+	ts_bspline_free (&curve->beziers);
+	free (curve->spans);
+	curve->spans = NULL;
+	curve->span_count = 0;
+}
+
+void lod_view_set_plane (lod_view_t* view, int plane, Vector3 normal, Vector3 point)
+{
+	view->normals[plane] = normal;
+	view->distances[plane] = -Vector3DotProduct (normal, point);
+}
+
+// screen_width and screen_height are the size of the render target in pixels
+// near and far should match the clipping distances used by the renderer
+void lod_view_initialize (lod_view_t* view, Camera3D camera, float screen_width, float screen_height, float near, float far, float tolerance)
+{
+	Vector3 forward = Vector3Normalize (Vector3Subtract (camera.target, camera.position));
+	Vector3 right = Vector3Normalize (Vector3CrossProduct (forward, camera.up));
+	Vector3 up = Vector3CrossProduct (right, forward);
+	float aspect = screen_width / screen_height;
+
+	view->position = camera.position;
+	view->forward = forward;
+	view->near = near;
+	view->tolerance = tolerance;
+	view->orthographic = camera.projection == CAMERA_ORTHOGRAPHIC;
+
+	lod_view_set_plane (view, 0, forward, Vector3Add (camera.position, Vector3Scale (forward, near)));
+	lod_view_set_plane (view, 1, Vector3Scale (forward, -1.0f), Vector3Add (camera.position, Vector3Scale (forward, far)));
+
+	if (view->orthographic)
+	{
+		// fovy is the height of the view volume
+		float half_height = camera.fovy / 2.0f;
+		float half_width = half_height * aspect;
+
+		lod_view_set_plane (view, 2, right, Vector3Subtract (camera.position, Vector3Scale (right, half_width)));
+		lod_view_set_plane (view, 3, Vector3Scale (right, -1.0f), Vector3Add (camera.position, Vector3Scale (right, half_width)));
+		lod_view_set_plane (view, 4, up, Vector3Subtract (camera.position, Vector3Scale (up, half_height)));
+		lod_view_set_plane (view, 5, Vector3Scale (up, -1.0f), Vector3Add (camera.position, Vector3Scale (up, half_height)));
+
+		view->pixel_scale = screen_height / camera.fovy;
+	}
+	else
+	{
+		float vertical = camera.fovy * 0.5f * (PI / 180.0f);
+		float horizontal = atanf (tanf (vertical) * aspect);
+
+		// the side planes all pass through the camera position
+		lod_view_set_plane (view, 2, Vector3Add (Vector3Scale (right, cosf (horizontal)), Vector3Scale (forward, sinf (horizontal))), camera.position);
+		lod_view_set_plane (view, 3, Vector3Add (Vector3Scale (right, -cosf (horizontal)), Vector3Scale (forward, sinf (horizontal))), camera.position);
+		lod_view_set_plane (view, 4, Vector3Add (Vector3Scale (up, cosf (vertical)), Vector3Scale (forward, sinf (vertical))), camera.position);
+		lod_view_set_plane (view, 5, Vector3Add (Vector3Scale (up, -cosf (vertical)), Vector3Scale (forward, sinf (vertical))), camera.position);
+
+		view->pixel_scale = (screen_height / 2.0f) / tanf (vertical);
+	}
+}
+
+// pick the number of segments for every span of curve
+// 	culled spans get 0 segments
+// returns the total number of segments
+// 	lod_emit writes two vertices per segment
+size_t lod_select (const lod_curve_t* curve, const lod_view_t* view, unsigned char* segments)
+{
+	size_t total = 0;
+
+	for (size_t span = 0; span < curve->span_count; span++)
+	{
+		const lod_span_t* bounds = &curve->spans[span];
+
+		segments[span] = 0;
+
+		bool visible = true;
+		for (int plane = 0; plane < 6 && visible; plane++)
+		{
+			visible = Vector3DotProduct (view->normals[plane], bounds->center) + view->distances[plane] >= -bounds->radius;
+		}
+		if (!visible)
+		{
+			continue;
+		}
+
+		// largest world space error that stays within the pixel budget
+		// 	measured at the point of the span closest to the camera
+		float error = view->tolerance / view->pixel_scale;
+		if (!view->orthographic)
+		{
+			float depth = Vector3DotProduct (Vector3Subtract (bounds->center, view->position), view->forward) - bounds->radius;
+			error *= fmaxf (depth, view->near);
+		}
+
+		float count = error > 0.0f ? ceilf (bounds->scale / sqrtf (error)) : LOD_MAX_SEGMENTS;
+		count = fminf (fmaxf (count, 1.0f), LOD_MAX_SEGMENTS);
+
+		segments[span] = (unsigned char) count;
+		total += segments[span];
+	}
+
+	return total;
+}
+
+// write the segments picked by lod_select to vertices as a list of lines
+// 	vertices must hold 2 * lod_select (...) vertices
+// returns the number of vertices written
+size_t lod_emit (const lod_curve_t* curve, const unsigned char* segments, Vector3* vertices)
+{
+	const tsReal* control_points = ts_bspline_control_points_ptr (&curve->beziers);
+	size_t count = 0;
+
+	for (size_t span = 0; span < curve->span_count; span++)
+	{
+		if (segments[span] == 0)
+		{
+			continue;
+		}
+
+		const tsReal* points = control_points + span * curve->order * curve->dimension;
+		Vector3 previous = lod_point (points, curve->dimension);
+
+		for (size_t segment = 1; segment <= segments[span]; segment++)
+		{
+			tsReal t = (tsReal) segment / segments[span];
+
+			// de casteljau on the span's control points
+			Vector3 scratch[LOD_MAX_ORDER];
+			for (size_t iter = 0; iter < curve->order; iter++)
+			{
+				scratch[iter] = lod_point (points + iter * curve->dimension, curve->dimension);
+			}
+			for (size_t level = 1; level < curve->order; level++)
+			{
+				for (size_t iter = 0; iter < curve->order - level; iter++)
+				{
+					scratch[iter] = Vector3Lerp (scratch[iter], scratch[iter + 1], t);
+				}
+			}
+
+			Vector3 next = scratch[0];
+			vertices[count++] = previous;
+			vertices[count++] = next;
+			previous = next;
+		}
+	}
+
+	return count;
+}
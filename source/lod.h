@@ -0,0 +1,69 @@
+#ifndef _lod_h_
+#define _lod_h_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "raylib.h"
+#include "tinyspline.h"
+
+// view-dependent tessellation of 3d splines
+// 	the spline is split into bezier spans
+// 	spans outside of the view frustum are culled
+// 	visible spans get just enough segments to stay within a screen space error budget
+//
+// only raylib types and raymath are used here
+// 	so lod selection works without a window or gpu
+
+#define LOD_MAX_SEGMENTS 64
+// highest supported spline order, bounds the de casteljau buffer of lod_emit
+#define LOD_MAX_ORDER 16
+// returned by lod_curve_initialize for splines of a higher order
+// 	chosen below the error codes of tinyspline
+#define LOD_ORDER_UNSUPPORTED ((tsError) -100)
+
+typedef struct
+{
+	// bounding sphere of the span's control points
+	// 	bezier curves lie inside the convex hull of their control points
+	Vector3 center;
+	float radius;
+	// world space chord error of one segment is at most scale^2
+	// 	so n segments have an error of at most (scale / n)^2
+	float scale;
+} lod_span_t;
+
+typedef struct
+{
+	tsBSpline beziers;
+	size_t span_count;
+	size_t order;
+	size_t dimension;
+	lod_span_t* spans;
+} lod_curve_t;
+
+typedef struct
+{
+	Vector3 position;
+	Vector3 forward;
+	// frustum planes with inward normals: near, far, left, right, bottom, top
+	// 	a point p is inside a plane if dot (normal, p) + distance >= 0
+	Vector3 normals[6];
+	float distances[6];
+	float near;
+	bool orthographic;
+	// pixels per world unit, divided by depth for perspective cameras
+	float pixel_scale;
+	// screen space error budget in pixels
+	float tolerance;
+} lod_view_t;
+
+tsError lod_curve_initialize (lod_curve_t* curve, const tsBSpline* spline, tsStatus* status);
+void lod_curve_cleanup (lod_curve_t* curve);
+
+void lod_view_initialize (lod_view_t* view, Camera3D camera, float screen_width, float screen_height, float near, float far, float tolerance);
+
+size_t lod_select (const lod_curve_t* curve, const lod_view_t* view, unsigned char* segments);
+size_t lod_emit (const lod_curve_t* curve, const unsigned char* segments, Vector3* vertices);
+
+#endif
@@ -9,6 +9,7 @@
 #include "demo_samples.h"
 #include "demo_interpolation.h"
 #include "demo_frames.h"
+#include "demo_stress.h"
 #include "common.h"
 
 int screen_width = 865;
@@ -19,6 +20,9 @@ typedef void (*demo_run) (struct nk_context*);
 typedef struct
 {
 	demo_function initialize;
+	// pick up results from background work, called at the start of every frame
+	// 	may be NULL
+	demo_function synchronize;
 	demo_run run;
 	demo_function draw;
 	demo_function cleanup;
@@ -30,12 +34,14 @@ enum
 	DEMO_SAMPLES,
 	DEMO_INTERPOLATION,
 	DEMO_FRAMES,
+	DEMO_STRESS,
 	DEMO_COUNT
 };
 
-void demo_initialize (demo_t* demo, demo_function initialize, demo_run run, demo_function draw, demo_function cleanup)
+void demo_initialize (demo_t* demo, demo_function initialize, demo_function synchronize, demo_run run, demo_function draw, demo_function cleanup)
 {
 	demo->initialize = initialize;
+	demo->synchronize = synchronize;
 	demo->run = run;
 	demo->draw = draw;
 	demo->cleanup = cleanup;
@@ -56,10 +62,11 @@ int main ()
 
 	struct nk_context* context = InitNuklearEx (font, 16);
 
-	demo_initialize (&demos[DEMO_EVAL], demo_eval_initialize, demo_eval_run, demo_eval_draw, demo_eval_cleanup);
-	demo_initialize (&demos[DEMO_SAMPLES], demo_samples_initialize, demo_samples_run, demo_samples_draw, demo_samples_cleanup);
-	demo_initialize (&demos[DEMO_INTERPOLATION], demo_interpolation_initialize, demo_interpolation_run, demo_interpolation_draw, demo_interpolation_cleanup);
-	demo_initialize (&demos[DEMO_FRAMES], demo_frames_initialize, demo_frames_run, demo_frames_draw, demo_frames_cleanup);
+	demo_initialize (&demos[DEMO_EVAL], demo_eval_initialize, NULL, demo_eval_run, demo_eval_draw, demo_eval_cleanup);
+	demo_initialize (&demos[DEMO_SAMPLES], demo_samples_initialize, NULL, demo_samples_run, demo_samples_draw, demo_samples_cleanup);
+	demo_initialize (&demos[DEMO_INTERPOLATION], demo_interpolation_initialize, demo_interpolation_synchronize, demo_interpolation_run, demo_interpolation_draw, demo_interpolation_cleanup);
+	demo_initialize (&demos[DEMO_FRAMES], demo_frames_initialize, demo_frames_synchronize, demo_frames_run, demo_frames_draw, demo_frames_cleanup);
+	demo_initialize (&demos[DEMO_STRESS], demo_stress_initialize, demo_stress_synchronize, demo_stress_run, demo_stress_draw, demo_stress_cleanup);
 
 	int current_demo = DEMO_FRAMES;
 
@@ -75,7 +82,7 @@ int main ()
 	{
 		if (nk_begin (context, "demo tabs", nk_rect (0, 0, screen_width, TAB_OFFSET), NK_WINDOW_NO_SCROLLBAR))
 		{
-			nk_layout_row_dynamic (context, 30, 4);
+			nk_layout_row_dynamic (context, 30, DEMO_COUNT);
 			if (nk_button_label (context, "Eval"))
 			{
 				current_demo = DEMO_EVAL;
@@ -92,9 +99,20 @@ int main ()
 			{
 				current_demo = DEMO_FRAMES;
 			}
+			if (nk_button_label (context, "Stress"))
+			{
+				current_demo = DEMO_STRESS;
+			}
 		}
 		nk_end (context);
 
+		// swap in finished results at the frame boundary
+		// 	the demo reads the same results for the rest of the frame
+		if (demos[current_demo].synchronize)
+		{
+			demos[current_demo].synchronize ();
+		}
+
 		demos[current_demo].run (context);
 
 		UpdateNuklear (context);
@@ -115,7 +133,7 @@ int main ()
 		EndDrawing ();
 	}
 
-	for (int iter = 0; iter < 2; iter++)
+	for (int iter = 0; iter < DEMO_COUNT; iter++)
 	{
 		demos[iter].cleanup ();
 	}
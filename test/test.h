@@ -0,0 +1,27 @@
+#ifndef _test_h_
+#define _test_h_
+
+#include <math.h>
+#include <stdio.h>
+
+#include "tinyspline.h"
+
+// minimal checks for the headless tests
+// 	failed checks are printed and counted, the test returns the count
+static int test_failures = 0;
+
+#define CHECK(condition) \
+	do \
+	{ \
+		if (!(condition)) \
+		{ \
+			printf ("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			test_failures++; \
+		} \
+	} while (0)
+
+#define CHECK_NEAR(a, b, tolerance) CHECK (fabs ((double) (a) - (double) (b)) <= (tolerance))
+
+#define CHECK_SUCCESS(call) CHECK ((call) == TS_SUCCESS)
+
+#endif
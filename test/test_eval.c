@@ -0,0 +1,158 @@
+#include <stdlib.h>
+
+#include "test.h"
+
+#define EVAL_TOLERANCE 1e-9
+
+// the point at knot as returned by ts_bspline_eval
+void eval_point (const tsBSpline* spline, tsReal knot, tsReal* point)
+{
+	tsDeBoorNet net = ts_deboornet_init ();
+	size_t dimension = ts_bspline_dimension (spline);
+
+	CHECK_SUCCESS (ts_bspline_eval (spline, knot, &net, NULL));
+	const tsReal* result = ts_deboornet_result_ptr (&net);
+	for (size_t iter = 0; iter < dimension; iter++)
+	{
+		point[iter] = result ? result[iter] : NAN;
+	}
+	ts_deboornet_free (&net);
+}
+
+void check_derivs_match_eval (const tsBSpline* spline, tsReal knot)
+{
+	tsReal derivs[3 * 3];
+	tsReal point[3];
+	size_t dimension = ts_bspline_dimension (spline);
+
+	CHECK_SUCCESS (ts_bspline_eval_derivs (spline, knot, 2, derivs, NULL));
+	eval_point (spline, knot, point);
+	for (size_t iter = 0; iter < dimension; iter++)
+	{
+		CHECK_NEAR (derivs[iter], point[iter], EVAL_TOLERANCE);
+	}
+}
+
+// piecewise quadratic bezier whose segments do not share their end points
+// 	so the spline jumps at the knots 1/3 and 2/3
+void test_gap ()
+{
+	tsReal control_points[9 * 2] =
+	{
+		0, 0,  1, 2,  2, 0,
+		3, 3,  4, 5,  5, 3,
+		6, -1,  7, 1,  8, -1,
+	};
+	tsBSpline spline = ts_bspline_init ();
+
+	CHECK_SUCCESS (ts_bspline_new (9, 2, 2, TS_BEZIERS, &spline, NULL));
+	CHECK_SUCCESS (ts_bspline_set_control_points (&spline, control_points, NULL));
+
+	const tsReal* knots = ts_bspline_knots_ptr (&spline);
+	for (size_t gap = 1; gap <= 2; gap++)
+	{
+		tsReal knot = knots[gap * 3];
+
+		// the left segment ends in its last control point
+		tsReal derivs[2];
+		CHECK_SUCCESS (ts_bspline_eval_derivs (&spline, knot, 0, derivs, NULL));
+		CHECK_NEAR (derivs[0], control_points[(gap * 3 - 1) * 2], EVAL_TOLERANCE);
+		CHECK_NEAR (derivs[1], control_points[(gap * 3 - 1) * 2 + 1], EVAL_TOLERANCE);
+
+		// knots within TS_KNOT_EPSILON are snapped to the gap
+		check_derivs_match_eval (&spline, knot);
+		check_derivs_match_eval (&spline, knot + TS_KNOT_EPSILON / 2);
+		check_derivs_match_eval (&spline, knot - TS_KNOT_EPSILON / 2);
+	}
+
+	for (int iter = 0; iter <= 100; iter++)
+	{
+		check_derivs_match_eval (&spline, iter / 100.0);
+	}
+
+	ts_bspline_free (&spline);
+}
+
+// the first derivative of a polyline jumps at its inner knots
+void test_kink ()
+{
+	tsReal control_points[3 * 2] = {0, 0, 1, 0, 1, 1};
+	tsBSpline spline = ts_bspline_init ();
+	tsReal derivs[2 * 2];
+
+	CHECK_SUCCESS (ts_bspline_new (3, 2, 1, TS_CLAMPED, &spline, NULL));
+	CHECK_SUCCESS (ts_bspline_set_control_points (&spline, control_points, NULL));
+	CHECK_SUCCESS (ts_bspline_eval_derivs (&spline, 0.5, 1, derivs, NULL));
+
+	CHECK_NEAR (derivs[0], 1.0, EVAL_TOLERANCE);
+	CHECK_NEAR (derivs[1], 0.0, EVAL_TOLERANCE);
+	CHECK_NEAR (derivs[2], 2.0, EVAL_TOLERANCE);
+	CHECK_NEAR (derivs[3], 0.0, EVAL_TOLERANCE);
+
+	ts_bspline_free (&spline);
+}
+
+// compares the rational evaluation with ts_bspline_eval_all plus weight division
+void check_rational_matches_eval (const tsReal* points, const tsReal* homogeneous, size_t count)
+{
+	for (size_t iter = 0; iter < count; iter++)
+	{
+		const tsReal* point = homogeneous + iter * 3;
+		CHECK_NEAR (points[iter * 2], point[0] / point[2], EVAL_TOLERANCE);
+		CHECK_NEAR (points[iter * 2 + 1], point[1] / point[2], EVAL_TOLERANCE);
+	}
+}
+
+// two quarter circles (homogeneous coordinates) whose segments do not meet
+void test_rational_gap ()
+{
+	const tsReal weight = sqrt (0.5);
+	tsReal control_points[6 * 3] =
+	{
+		1, 0, 1,  weight, weight, weight,  0, 1, 1,
+		3, 0, 1,  3 * weight, -3 * weight, weight,  0, -3, 1,
+	};
+	tsBSpline spline = ts_bspline_init ();
+
+	CHECK_SUCCESS (ts_bspline_new (6, 3, 2, TS_BEZIERS, &spline, NULL));
+	CHECK_SUCCESS (ts_bspline_set_control_points (&spline, control_points, NULL));
+
+	// the gap knot and its TS_KNOT_EPSILON window
+	tsReal knots[5] = {0.0, 0.5 - TS_KNOT_EPSILON / 2, 0.5, 0.5 + TS_KNOT_EPSILON / 2, 1.0};
+	tsReal* points = NULL;
+	tsReal* homogeneous = NULL;
+	CHECK_SUCCESS (ts_bspline_eval_all_rational (&spline, knots, 5, &points, NULL));
+	CHECK_SUCCESS (ts_bspline_eval_all (&spline, knots, 5, &homogeneous, NULL));
+	if (points && homogeneous)
+	{
+		check_rational_matches_eval (points, homogeneous, 5);
+		// the left segment ends in (0, 1)
+		CHECK_NEAR (points[4], 0.0, EVAL_TOLERANCE);
+		CHECK_NEAR (points[5], 1.0, EVAL_TOLERANCE);
+	}
+	free (points);
+	free (homogeneous);
+
+	// uniform sampling with an odd count lands on the gap knot
+	size_t count = 0;
+	points = homogeneous = NULL;
+	CHECK_SUCCESS (ts_bspline_sample_rational (&spline, 101, &points, &count, NULL));
+	CHECK_SUCCESS (ts_bspline_sample (&spline, 101, &homogeneous, &count, NULL));
+	if (points && homogeneous)
+	{
+		check_rational_matches_eval (points, homogeneous, count);
+	}
+	free (points);
+	free (homogeneous);
+
+	ts_bspline_free (&spline);
+}
+
+int main ()
+{
+	test_gap ();
+	test_kink ();
+	test_rational_gap ();
+
+	return test_failures;
+}
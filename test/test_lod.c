@@ -0,0 +1,103 @@
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "test.h"
+#include "source/lod.h"
+
+// camera at the origin looking down -z
+void create_view (lod_view_t* view)
+{
+	Camera3D camera = {0};
+	camera.position = (Vector3) {0.0f, 0.0f, 0.0f};
+	camera.target = (Vector3) {0.0f, 0.0f, -1.0f};
+	camera.up = (Vector3) {0.0f, 1.0f, 0.0f};
+	camera.fovy = 60.0f;
+	camera.projection = CAMERA_PERSPECTIVE;
+
+	lod_view_initialize (view, camera, 512.0f, 512.0f, 0.01f, 1000.0f, 0.5f);
+}
+
+// cubic with the given control points
+void create_curve (lod_curve_t* curve, const tsReal* control_points, size_t count)
+{
+	tsBSpline spline = ts_bspline_init ();
+
+	CHECK_SUCCESS (ts_bspline_new (count, 3, 3, TS_CLAMPED, &spline, NULL));
+	CHECK_SUCCESS (ts_bspline_set_control_points (&spline, control_points, NULL));
+	CHECK_SUCCESS (lod_curve_initialize (curve, &spline, NULL));
+	ts_bspline_free (&spline);
+}
+
+// selects and emits curve, returns the number of emitted vertices
+size_t tessellate (const lod_curve_t* curve, const lod_view_t* view, unsigned char* segments)
+{
+	size_t segment_count = lod_select (curve, view, segments);
+	Vector3* vertices = malloc ((segment_count * 2 + 1) * sizeof (Vector3));
+	size_t vertex_count = lod_emit (curve, segments, vertices);
+
+	CHECK (vertex_count == segment_count * 2);
+	free (vertices);
+
+	return vertex_count;
+}
+
+// a curve behind the camera is culled completely
+void test_culled ()
+{
+	tsReal control_points[4 * 3] = {-5, 0, 20,  -2, 5, 30,  2, -5, 30,  5, 0, 20};
+	unsigned char segments[1];
+	lod_curve_t curve;
+	lod_view_t view;
+
+	create_view (&view);
+	create_curve (&curve, control_points, 4);
+	CHECK (curve.span_count == 1);
+	CHECK (tessellate (&curve, &view, segments) == 0);
+	CHECK (segments[0] == 0);
+
+	lod_curve_cleanup (&curve);
+}
+
+// evenly spaced collinear control points need a single segment, a bent span in view needs more
+// 	(the bound is on the parametric error, so unevenly spaced collinear points are still refined)
+void test_refinement ()
+{
+	tsReal flat[4 * 3] = {-3, 0, -10,  -1, 0, -10,  1, 0, -10,  3, 0, -10};
+	tsReal bent[4 * 3] = {-4, 0, -10,  -4, 6, -10,  4, -6, -10,  4, 0, -10};
+	unsigned char segments[1];
+	lod_curve_t curve;
+	lod_view_t view;
+
+	create_view (&view);
+
+	create_curve (&curve, flat, 4);
+	CHECK (tessellate (&curve, &view, segments) == 2);
+	CHECK (segments[0] == 1);
+	lod_curve_cleanup (&curve);
+
+	create_curve (&curve, bent, 4);
+	CHECK (tessellate (&curve, &view, segments) > 2);
+	CHECK (segments[0] > 1);
+	lod_curve_cleanup (&curve);
+}
+
+void test_max_order ()
+{
+	tsBSpline spline = ts_bspline_init ();
+	tsStatus status;
+	lod_curve_t curve;
+
+	CHECK_SUCCESS (ts_bspline_new (LOD_MAX_ORDER + 1, 3, LOD_MAX_ORDER, TS_CLAMPED, &spline, NULL));
+	CHECK (lod_curve_initialize (&curve, &spline, &status) == LOD_ORDER_UNSUPPORTED);
+	CHECK (status.code == LOD_ORDER_UNSUPPORTED);
+	ts_bspline_free (&spline);
+}
+
+int main ()
+{
+	test_culled ();
+	test_refinement ();
+	test_max_order ();
+
+	return test_failures;
+}
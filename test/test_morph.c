@@ -0,0 +1,65 @@
+#include <stdlib.h>
+
+#include "test.h"
+
+// aligning origin and target refines their knots, which rounds differently than the unaligned splines
+#define MORPH_TOLERANCE 1e-9
+
+// checks that morph evaluates like reference on a uniform knot sequence
+void check_same_curve (const tsBSpline* morph, const tsBSpline* reference)
+{
+	tsReal* points = NULL;
+	tsReal* expected = NULL;
+	size_t count = 0;
+
+	CHECK_SUCCESS (ts_bspline_sample (morph, 51, &points, &count, NULL));
+	CHECK_SUCCESS (ts_bspline_sample (reference, 51, &expected, &count, NULL));
+	if (points && expected)
+	{
+		for (size_t iter = 0; iter < count * ts_bspline_dimension (reference); iter++)
+		{
+			CHECK_NEAR (points[iter], expected[iter], MORPH_TOLERANCE);
+		}
+	}
+	free (points);
+	free (expected);
+}
+
+int main ()
+{
+	tsReal origin_points[7 * 2] = {0, 0, 1, 2, 3, 1, 4, 4, 6, 3, 7, 0, 9, 1};
+	tsReal target_points[5 * 2] = {0, 5, 2, 7, 5, 6, 7, 8, 9, 5};
+	tsBSpline origin = ts_bspline_init ();
+	tsBSpline target = ts_bspline_init ();
+	tsBSpline morph = ts_bspline_init ();
+	tsBSpline planned = ts_bspline_init ();
+	tsMorphPlan plan = ts_morphplan_init ();
+
+	CHECK_SUCCESS (ts_bspline_new (7, 2, 3, TS_CLAMPED, &origin, NULL));
+	CHECK_SUCCESS (ts_bspline_set_control_points (&origin, origin_points, NULL));
+	CHECK_SUCCESS (ts_bspline_new (5, 2, 2, TS_CLAMPED, &target, NULL));
+	CHECK_SUCCESS (ts_bspline_set_control_points (&target, target_points, NULL));
+	CHECK_SUCCESS (ts_morphplan_new (&origin, &target, TS_POINT_EPSILON, &plan, NULL));
+
+	// the end points of the blend are the input curves, equal within rounding
+	CHECK_SUCCESS (ts_bspline_morph (&origin, &target, 0.0, TS_POINT_EPSILON, &morph, NULL));
+	check_same_curve (&morph, &origin);
+	CHECK_SUCCESS (ts_bspline_morph (&origin, &target, 1.0, TS_POINT_EPSILON, &morph, NULL));
+	check_same_curve (&morph, &target);
+
+	// plans share the blend with ts_bspline_morph
+	for (int iter = 0; iter <= 4; iter++)
+	{
+		CHECK_SUCCESS (ts_bspline_morph (&origin, &target, iter / 4.0, TS_POINT_EPSILON, &morph, NULL));
+		CHECK_SUCCESS (ts_morphplan_eval (&plan, iter / 4.0, &planned, NULL));
+		check_same_curve (&planned, &morph);
+	}
+
+	ts_bspline_free (&origin);
+	ts_bspline_free (&target);
+	ts_bspline_free (&morph);
+	ts_bspline_free (&planned);
+	ts_morphplan_free (&plan);
+
+	return test_failures;
+}
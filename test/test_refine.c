@@ -0,0 +1,156 @@
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "test.h"
+
+// refinement and repeated single insertions round differently
+#define REFINE_TOLERANCE 1e-9
+
+// inserts every knot of knots via ts_bspline_insert_knot until its multiplicity equals the order
+tsError insert_to_order (const tsBSpline* spline, const tsReal* knots, size_t count, tsBSpline* result)
+{
+	tsError error = ts_bspline_copy (spline, result, NULL);
+
+	for (size_t iter = 0; iter < count && error == TS_SUCCESS; iter++)
+	{
+		const tsReal* vector = ts_bspline_knots_ptr (result);
+		size_t multiplicity = 0;
+		for (size_t knot = 0; knot < ts_bspline_num_knots (result); knot++)
+		{
+			multiplicity += ts_knots_equal (vector[knot], knots[iter]);
+		}
+
+		size_t insertions = ts_bspline_order (result) - multiplicity;
+		if (insertions > 0)
+		{
+			size_t index;
+			error = ts_bspline_insert_knot (result, knots[iter], insertions, result, &index, NULL);
+		}
+	}
+
+	return error;
+}
+
+// compares the control points of actual with those of expected, starting at control point offset
+void check_control_points (const tsBSpline* actual, const tsBSpline* expected, size_t offset, bool reversed)
+{
+	size_t dimension = ts_bspline_dimension (actual);
+	size_t count = ts_bspline_num_control_points (actual);
+
+	CHECK (offset + count <= ts_bspline_num_control_points (expected));
+	if (offset + count > ts_bspline_num_control_points (expected))
+	{
+		return;
+	}
+
+	const tsReal* points = ts_bspline_control_points_ptr (actual);
+	const tsReal* reference = ts_bspline_control_points_ptr (expected);
+	for (size_t point = 0; point < count; point++)
+	{
+		size_t other = offset + (reversed ? count - 1 - point : point);
+		for (size_t iter = 0; iter < dimension; iter++)
+		{
+			CHECK_NEAR (points[point * dimension + iter], reference[other * dimension + iter], REFINE_TOLERANCE);
+		}
+	}
+}
+
+// index of the first occurrence of knot in the knot vector of spline
+size_t find_knot (const tsBSpline* spline, tsReal knot)
+{
+	const tsReal* knots = ts_bspline_knots_ptr (spline);
+	size_t index = 0;
+
+	while (index < ts_bspline_num_knots (spline) && !ts_knots_equal (knots[index], knot))
+	{
+		index++;
+	}
+
+	return index;
+}
+
+// non-uniform clamped cubic with a double knot at 0.5
+void create_spline (tsBSpline* spline)
+{
+	tsReal control_points[9 * 2] =
+	{
+		0, 0,  1, 3,  2, -1,  4, 2,  5, 5,  7, 1,  8, -2,  9, 4,  11, 0,
+	};
+	tsReal knots[13] = {0, 0, 0, 0, 0.1, 0.25, 0.5, 0.5, 0.8, 1, 1, 1, 1};
+
+	CHECK_SUCCESS (ts_bspline_new (9, 2, 3, TS_CLAMPED, spline, NULL));
+	CHECK_SUCCESS (ts_bspline_set_control_points (spline, control_points, NULL));
+	CHECK_SUCCESS (ts_bspline_set_knots (spline, knots, NULL));
+}
+
+void test_split ()
+{
+	tsBSpline spline = ts_bspline_init ();
+	tsReal knots[3] = {0.3, 0.5, 0.8};
+
+	create_spline (&spline);
+	for (size_t iter = 0; iter < 3; iter++)
+	{
+		tsBSpline split = ts_bspline_init ();
+		tsBSpline expected = ts_bspline_init ();
+		size_t index;
+
+		CHECK_SUCCESS (ts_bspline_split (&spline, knots[iter], &split, &index, NULL));
+		CHECK_SUCCESS (insert_to_order (&spline, &knots[iter], 1, &expected));
+		CHECK (ts_bspline_num_control_points (&split) == ts_bspline_num_control_points (&expected));
+		check_control_points (&split, &expected, 0, false);
+
+		ts_bspline_free (&split);
+		ts_bspline_free (&expected);
+	}
+	ts_bspline_free (&spline);
+}
+
+void test_to_beziers ()
+{
+	tsBSpline spline = ts_bspline_init ();
+	tsBSpline beziers = ts_bspline_init ();
+	tsBSpline expected = ts_bspline_init ();
+	tsReal knots[4] = {0.1, 0.25, 0.5, 0.8};
+
+	create_spline (&spline);
+	CHECK_SUCCESS (ts_bspline_to_beziers (&spline, &beziers, NULL));
+	CHECK_SUCCESS (insert_to_order (&spline, knots, 4, &expected));
+	CHECK (ts_bspline_num_control_points (&beziers) == 5 * 4);
+	CHECK (ts_bspline_num_control_points (&beziers) == ts_bspline_num_control_points (&expected));
+	check_control_points (&beziers, &expected, 0, false);
+
+	ts_bspline_free (&spline);
+	ts_bspline_free (&beziers);
+	ts_bspline_free (&expected);
+}
+
+void test_sub_spline ()
+{
+	tsBSpline spline = ts_bspline_init ();
+	tsReal knots[2] = {0.2, 0.65};
+
+	create_spline (&spline);
+	for (int reversed = 0; reversed < 2; reversed++)
+	{
+		tsBSpline sub = ts_bspline_init ();
+		tsBSpline expected = ts_bspline_init ();
+
+		CHECK_SUCCESS (ts_bspline_sub_spline (&spline, knots[reversed], knots[!reversed], &sub, NULL));
+		CHECK_SUCCESS (insert_to_order (&spline, knots, 2, &expected));
+		check_control_points (&sub, &expected, find_knot (&expected, knots[0]), reversed);
+
+		ts_bspline_free (&sub);
+		ts_bspline_free (&expected);
+	}
+	ts_bspline_free (&spline);
+}
+
+int main ()
+{
+	test_split ();
+	test_to_beziers ();
+	test_sub_spline ();
+
+	return test_failures;
+}
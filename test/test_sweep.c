@@ -0,0 +1,122 @@
+#include <limits.h>
+#include <stdlib.h>
+
+#include "test.h"
+
+#define SWEEP_TOLERANCE 1e-6
+#define PROFILE_COUNT 8
+#define STEP_COUNT 10
+
+// cubic along the x axis from 0 to 10, evenly spaced so that x is linear in the knot
+void create_line (tsBSpline* spline)
+{
+	tsReal control_points[4 * 3] = {0, 0, 0,  10.0 / 3, 0, 0,  20.0 / 3, 0, 0,  10, 0, 0};
+
+	CHECK_SUCCESS (ts_bspline_new (4, 3, 3, TS_CLAMPED, spline, NULL));
+	CHECK_SUCCESS (ts_bspline_set_control_points (spline, control_points, NULL));
+}
+
+// unit circle, counter-clockwise
+void create_profile (tsReal* profile)
+{
+	for (size_t iter = 0; iter < PROFILE_COUNT; iter++)
+	{
+		double angle = 2.0 * TS_PI * iter / PROFILE_COUNT;
+		profile[iter * 2 + 0] = (tsReal) cos (angle);
+		profile[iter * 2 + 1] = (tsReal) sin (angle);
+	}
+}
+
+tsSink create_sink (double* data)
+{
+	tsSink sink = {data, 0, 0, 3, TS_SINK_DOUBLE};
+	return sink;
+}
+
+// a tube around a straight line: every ring is a unit circle around the x axis
+// 	with radial normals, i.e. unit length and orthogonal to the tangent (1, 0, 0)
+void test_tube ()
+{
+	size_t quad_count = PROFILE_COUNT;
+	size_t index_count = (STEP_COUNT - 1) * quad_count * 6;
+
+	tsReal profile[PROFILE_COUNT * 2];
+	double vertices[STEP_COUNT * PROFILE_COUNT * 3];
+	double normals[STEP_COUNT * PROFILE_COUNT * 3];
+	unsigned int* indices = malloc ((index_count + 1) * sizeof (unsigned int));
+	tsBSpline spline = ts_bspline_init ();
+	tsSink vertex_sink = create_sink (vertices);
+	tsSink normal_sink = create_sink (normals);
+	size_t ring_count = 0;
+
+	create_line (&spline);
+	create_profile (profile);
+
+	// the entry past the end must stay untouched
+	for (size_t iter = 0; iter <= index_count; iter++)
+	{
+		indices[iter] = UINT_MAX;
+	}
+
+	CHECK_SUCCESS (ts_bspline_sweep (&spline, profile, PROFILE_COUNT, 1, STEP_COUNT, 0, &vertex_sink, &normal_sink, indices, &ring_count, NULL));
+	CHECK (ring_count == STEP_COUNT);
+
+	for (size_t iter = 0; iter < index_count; iter++)
+	{
+		CHECK (indices[iter] < ring_count * PROFILE_COUNT);
+	}
+	CHECK (indices[index_count] == UINT_MAX);
+
+	for (size_t ring = 0; ring < ring_count; ring++)
+	{
+		for (size_t point = 0; point < PROFILE_COUNT; point++)
+		{
+			const double* vertex = vertices + (ring * PROFILE_COUNT + point) * 3;
+			const double* normal = normals + (ring * PROFILE_COUNT + point) * 3;
+
+			CHECK_NEAR (vertex[0], 10.0 * ring / (STEP_COUNT - 1), SWEEP_TOLERANCE);
+			CHECK_NEAR (sqrt (vertex[1] * vertex[1] + vertex[2] * vertex[2]), 1.0, SWEEP_TOLERANCE);
+
+			CHECK_NEAR (sqrt (normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]), 1.0, SWEEP_TOLERANCE);
+			CHECK_NEAR (normal[0], 0.0, SWEEP_TOLERANCE);
+		}
+	}
+
+	free (indices);
+	ts_bspline_free (&spline);
+}
+
+// an open profile has one quad less per ring
+// 	and a straight line needs only the first and last ring when placed adaptively
+void test_adaptive_ribbon ()
+{
+	size_t quad_count = PROFILE_COUNT - 1;
+
+	tsReal profile[PROFILE_COUNT * 2];
+	double vertices[STEP_COUNT * PROFILE_COUNT * 3];
+	unsigned int indices[(STEP_COUNT - 1) * (PROFILE_COUNT - 1) * 6];
+	tsBSpline spline = ts_bspline_init ();
+	tsSink vertex_sink = create_sink (vertices);
+	size_t ring_count = 0;
+
+	create_line (&spline);
+	create_profile (profile);
+
+	CHECK_SUCCESS (ts_bspline_sweep (&spline, profile, PROFILE_COUNT, 0, STEP_COUNT, 0.1, &vertex_sink, NULL, indices, &ring_count, NULL));
+	CHECK (ring_count == 2);
+	for (size_t iter = 0; iter < (ring_count - 1) * quad_count * 6; iter++)
+	{
+		CHECK (indices[iter] < ring_count * PROFILE_COUNT);
+	}
+	CHECK_NEAR (vertices[PROFILE_COUNT * 3], 10.0, SWEEP_TOLERANCE);
+
+	ts_bspline_free (&spline);
+}
+
+int main ()
+{
+	test_tube ();
+	test_adaptive_ribbon ();
+
+	return test_failures;
+}